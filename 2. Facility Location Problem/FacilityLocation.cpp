@@ -12,7 +12,9 @@
 #include <algorithm>	// For range of elements, subsets of elements
 #include <assert.h>		// Diagnostic messages and verify program assumptions
 #include <cmath>		// Perform math operations, sqrt(), log(), ...
+#include <cstdint>		// Fixed width integers, uint64_t, ...
 #include <cstdlib>		// General purpose function, abs(), ...
+#include <cstring>		// Memory blocks, memcpy(), memcmp(), ...
 #include <ctime>		// Converts time to character string
 #include <fstream>		// Open file for writing
 #include <ilcplex/ilocplex.h>	// CPLEX library
@@ -21,6 +23,17 @@
 #include <stdio.h>		// File input and output
 #include <stdlib.h>		// Memory allocation, process control, conversion, ...
 #include <string>		// String manipulation
+#include <unordered_map>	// Hash map for demand clusters
+#include <vector>		// Dynamic arrays
+
+#ifdef _WIN32
+#include <windows.h>	// File mapping API, CreateFileMapping(), MapViewOfFile(), ...
+#else
+#include <fcntl.h>		// open()
+#include <sys/mman.h>	// Memory-mapped files, mmap(), munmap(), ...
+#include <sys/stat.h>	// File size, fstat()
+#include <unistd.h>		// close(), pread(), sysconf()
+#endif
 
 ILOSTLBEGIN  // IBM macro to allow run the application in c++ with STL (Standard Template Library)
 
@@ -358,6 +371,416 @@ void uncapacitatedFacilityLocation()
 }
 #pragma endregion
 
+#pragma region Streaming Customer Ingestion
+
+// Binary customer file: one CustomerFileHeader followed by customerCount CustomerRecord entries
+// Records are read through a sliding memory-mapped window, so peak memory is bounded by the chunk size
+struct CustomerFileHeader {
+	char magic[8];				// File signature "WMCUST01"
+	uint64_t customerCount;		// Number of customer records stored after the header
+};
+
+struct CustomerRecord {
+	double x;		// x coordinate of customer j
+	double y;		// y coordinate of customer j
+	double demand;	// Demand of customer j
+};
+
+static const char customerFileMagic[8] = { 'W', 'M', 'C', 'U', 'S', 'T', '0', '1' };
+
+// Creates writeCustomerFile method, writes n random customers to a binary file (bool: true if written)
+bool writeCustomerFile(const string& path, uint64_t n, unsigned int seed)
+{
+	std::ofstream oFile(path.c_str(), std::ios::binary);
+	if (!oFile)
+		return false;
+
+	CustomerFileHeader header;
+	memcpy(header.magic, customerFileMagic, sizeof(header.magic));
+	header.customerCount = n;
+	oFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	// Records are buffered so the file is written with large sequential writes
+	const size_t bufferSize = 65536;
+	vector<CustomerRecord> buffer;
+	buffer.reserve(bufferSize);
+
+	srand(seed);
+	for (uint64_t j = 0; j < n; j++) {
+		CustomerRecord record;
+		record.x = (rand() % 10000) / 100.0;		// Coordinates in [0, 100)
+		record.y = (rand() % 10000) / 100.0;
+		record.demand = 1 + rand() % 50;			// Demand in [1, 50]
+		buffer.push_back(record);
+
+		if (buffer.size() == bufferSize) {
+			oFile.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(CustomerRecord));
+			buffer.clear();
+		}
+	}
+	oFile.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(CustomerRecord));
+
+	oFile.close();        // Closes ouput file
+	return !oFile.fail();
+}
+
+// Class for reading a binary customer file in chunks through a memory-mapped window
+class CustomerStream
+{
+#ifdef _WIN32
+	HANDLE file;			// File handle
+	HANDLE mapping;			// File mapping handle
+#else
+	int file;				// File descriptor
+#endif
+	uint64_t fileSize;		// Size of the file in bytes
+	uint64_t customerCount;	// Number of customers in the file
+	uint64_t chunkSize;		// Number of customers mapped per chunk
+	uint64_t nextCustomer;	// Index of the first customer of the next chunk
+	uint64_t granularity;	// Alignment required for the mapping offset
+	void* view;				// Currently mapped window
+	size_t viewLength;		// Length of the mapped window in bytes
+
+	// Releases the currently mapped window
+	void unmapView();
+
+	// The stream owns OS handles, so it cannot be copied
+	CustomerStream(const CustomerStream&);
+	CustomerStream& operator=(const CustomerStream&);
+
+public:
+
+	// Constructor, opens the file and validates its header
+	CustomerStream(const string& path, uint64_t chunkSize);
+
+	// Destructor, unmaps the window and closes the file
+	~CustomerStream();
+
+	// Returns true if the file was opened and has a valid header
+	bool isOpen() const { return customerCount != UINT64_MAX; }
+
+	// Number of customers in the file
+	uint64_t size() const { return customerCount; }
+
+	// Restarts the stream at the first customer
+	void rewind() { nextCustomer = 0; }
+
+	// Maps the next chunk of customers, returns false when the file is exhausted
+	bool nextChunk(const CustomerRecord*& records, uint64_t& count);
+};
+
+CustomerStream::CustomerStream(const string& path, uint64_t chunkSize)
+{
+	this->chunkSize = chunkSize > 0 ? chunkSize : 1;
+	customerCount = UINT64_MAX;
+	nextCustomer = 0;
+	fileSize = 0;
+	view = NULL;
+	viewLength = 0;
+
+#ifdef _WIN32
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo(&systemInfo);
+	granularity = systemInfo.dwAllocationGranularity;
+
+	mapping = NULL;
+	file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size))
+		return;
+	fileSize = (uint64_t)size.QuadPart;
+
+	mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+		return;
+
+	CustomerFileHeader header;
+	DWORD bytesRead = 0;
+	if (!ReadFile(file, &header, sizeof(header), &bytesRead, NULL) || bytesRead != sizeof(header))
+		return;
+#else
+	granularity = (uint64_t)sysconf(_SC_PAGE_SIZE);
+
+	file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+		return;
+
+	struct stat fileStatus;
+	if (fstat(file, &fileStatus) != 0)
+		return;
+	fileSize = (uint64_t)fileStatus.st_size;
+
+	CustomerFileHeader header;
+	if (pread(file, &header, sizeof(header), 0) != (ssize_t)sizeof(header))
+		return;
+#endif
+
+	// Validate signature and that the file holds every record announced in the header
+	if (memcmp(header.magic, customerFileMagic, sizeof(header.magic)) != 0)
+		return;
+	if ((fileSize - sizeof(header)) / sizeof(CustomerRecord) < header.customerCount)
+		return;
+
+	customerCount = header.customerCount;
+}
+
+CustomerStream::~CustomerStream()
+{
+	unmapView();
+#ifdef _WIN32
+	if (mapping != NULL)
+		CloseHandle(mapping);
+	if (file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+#else
+	if (file >= 0)
+		close(file);
+#endif
+}
+
+void CustomerStream::unmapView()
+{
+	if (view == NULL)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(view);
+#else
+	munmap(view, viewLength);
+#endif
+	view = NULL;
+	viewLength = 0;
+}
+
+bool CustomerStream::nextChunk(const CustomerRecord*& records, uint64_t& count)
+{
+	// Only one window is mapped at a time
+	unmapView();
+
+	if (!isOpen() || nextCustomer >= customerCount)
+		return false;
+
+	count = min(chunkSize, customerCount - nextCustomer);
+
+	// Mapping offsets must be aligned, so the window starts at the preceding aligned byte
+	uint64_t firstByte = sizeof(CustomerFileHeader) + nextCustomer * sizeof(CustomerRecord);
+	uint64_t alignedByte = firstByte - firstByte % granularity;
+	viewLength = (size_t)(firstByte - alignedByte + count * sizeof(CustomerRecord));
+
+#ifdef _WIN32
+	view = MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(alignedByte >> 32), (DWORD)(alignedByte & 0xFFFFFFFF), viewLength);
+	if (view == NULL) {
+		viewLength = 0;
+		return false;
+	}
+#else
+	view = mmap(NULL, viewLength, PROT_READ, MAP_SHARED, file, (off_t)alignedByte);
+	if (view == MAP_FAILED) {
+		view = NULL;
+		viewLength = 0;
+		return false;
+	}
+	madvise(view, viewLength, MADV_SEQUENTIAL);	// Hint read-ahead for the sequential scan
+#endif
+
+	records = reinterpret_cast<const CustomerRecord*>(static_cast<const char*>(view) + (firstByte - alignedByte));
+	nextCustomer += count;
+	return true;
+}
+
+// Creates structure DemandCluster, aggregated demand of the customers inside one grid cell
+struct DemandCluster {
+	double x;				// Demand-weighted centroid x
+	double y;				// Demand-weighted centroid y
+	double demand;			// Total demand of the cluster
+	uint64_t customers;		// Number of aggregated customers
+};
+
+// Creates aggregateDemandClusters method, streams the customers into square grid cells of side cellSize
+// Memory grows with the number of occupied cells, not with the number of customers
+vector<DemandCluster> aggregateDemandClusters(CustomerStream& stream, double cellSize)
+{
+	unordered_map<uint64_t, size_t> clusterIndex;	// Grid cell key -> position in clusters
+	vector<DemandCluster> clusters;
+
+	const CustomerRecord* records;
+	uint64_t count;
+
+	stream.rewind();
+	while (stream.nextChunk(records, count)) {
+		for (uint64_t j = 0; j < count; j++) {
+			const CustomerRecord& customer = records[j];
+
+			// Cell key packs the two 32-bit cell coordinates
+			int64_t cellX = (int64_t)floor(customer.x / cellSize);
+			int64_t cellY = (int64_t)floor(customer.y / cellSize);
+			uint64_t key = ((uint64_t)(uint32_t)cellX << 32) | (uint32_t)cellY;
+
+			unordered_map<uint64_t, size_t>::iterator it = clusterIndex.find(key);
+			if (it == clusterIndex.end()) {
+				it = clusterIndex.insert(make_pair(key, clusters.size())).first;
+				DemandCluster cluster = { 0, 0, 0, 0 };
+				clusters.push_back(cluster);
+			}
+
+			// Accumulate weighted coordinates, divided by the total demand once the stream ends
+			DemandCluster& cluster = clusters[it->second];
+			cluster.x += customer.demand * customer.x;
+			cluster.y += customer.demand * customer.y;
+			cluster.demand += customer.demand;
+			cluster.customers++;
+		}
+	}
+
+	for (size_t k = 0; k < clusters.size(); k++) {
+		if (clusters[k].demand > 0) {
+			clusters[k].x /= clusters[k].demand;
+			clusters[k].y /= clusters[k].demand;
+		}
+	}
+	return clusters;
+}
+
+// Creates structure FacilitySolutionCost, cost breakdown of one open-facility solution
+struct FacilitySolutionCost {
+	double fixedCost;				// Sum of f[i] over open facilities
+	double transportCost;			// Sum of demand times distance cost to the closest open facility
+	double totalCost;				// fixedCost + transportCost
+	vector<double> assignedDemand;	// Demand served by facility i
+};
+
+// Creates evaluateOpenFacilities method, evaluates several open-facility vectors x[i] in one streaming pass
+// Every customer is served by its closest open facility at costPerDistance per unit of demand and distance
+vector<FacilitySolutionCost> evaluateOpenFacilities(CustomerStream& stream, const vector<double>& facilityX, const vector<double>& facilityY,
+	const vector<double>& f, const vector< vector<int> >& openSolutions, double costPerDistance)
+{
+	const size_t I = facilityX.size();
+	vector<FacilitySolutionCost> costs(openSolutions.size());
+
+	for (size_t s = 0; s < openSolutions.size(); s++) {
+		costs[s].fixedCost = 0;
+		costs[s].transportCost = 0;
+		costs[s].assignedDemand.assign(I, 0);
+		for (size_t i = 0; i < I; i++)
+			if (openSolutions[s][i])
+				costs[s].fixedCost += f[i];
+	}
+
+	vector<double> distance(I);		// Distance of the current customer to facility i
+	const CustomerRecord* records;
+	uint64_t count;
+
+	stream.rewind();
+	while (stream.nextChunk(records, count)) {
+		for (uint64_t j = 0; j < count; j++) {
+			const CustomerRecord& customer = records[j];
+
+			// Distances are shared by every evaluated solution
+			for (size_t i = 0; i < I; i++) {
+				double dx = customer.x - facilityX[i];
+				double dy = customer.y - facilityY[i];
+				distance[i] = sqrt(dx * dx + dy * dy);
+			}
+
+			for (size_t s = 0; s < openSolutions.size(); s++) {
+				size_t closest = I;
+				for (size_t i = 0; i < I; i++)
+					if (openSolutions[s][i] && (closest == I || distance[i] < distance[closest]))
+						closest = i;
+
+				if (closest == I)
+					continue;	// No open facility, the solution is infeasible
+				costs[s].transportCost += costPerDistance * customer.demand * distance[closest];
+				costs[s].assignedDemand[closest] += customer.demand;
+			}
+		}
+	}
+
+	for (size_t s = 0; s < openSolutions.size(); s++) {
+		bool anyOpen = false;
+		for (size_t i = 0; i < I; i++)
+			anyOpen = anyOpen || openSolutions[s][i];
+		costs[s].totalCost = anyOpen ? costs[s].fixedCost + costs[s].transportCost : HUGE_VAL;
+	}
+	return costs;
+}
+
+// Creates streamingFacilityLocation method, aggregates and evaluates a customer file larger than the CPLEX examples
+void streamingFacilityLocation()
+{
+	cout << "-----------Streaming Facility Location-------------" << endl;
+
+	//Define parameters
+	const int I = 3;							// Set of facilities, cardinality
+	const uint64_t J = 1000000;					// Set of customers, cardinality
+	const uint64_t chunkSize = 65536;			// Customers mapped per chunk
+	const double cellSize = 10;					// Side of the demand cluster grid cells
+	const double costPerDistance = 0.01;		// Transport cost per unit of demand and distance
+	const string path = "StreamingCustomers.bin";
+
+	vector<double> facilityX = { 20, 50, 80 };	// x coordinate of facility i
+	vector<double> facilityY = { 30, 70, 40 };	// y coordinate of facility i
+	vector<double> f = { 3000, 4000, 5000 };	// Cost of adding facility i.
+
+	if (!writeCustomerFile(path, J, 2021)) {
+		cout << "Unable to write " << path << endl;
+		remove(path.c_str());
+		return;
+	}
+
+	// The stream closes the file at the end of this block, so the file can then be removed
+	{
+		CustomerStream stream(path, chunkSize);
+		if (!stream.isOpen())
+			cout << "Unable to open " << path << endl;
+		else {
+			cout << "Customers in file: " << stream.size() << " (" << chunkSize << " per chunk)" << endl;
+
+			// Aggregate the customers into demand clusters (a reduced J for the CPLEX models)
+			vector<DemandCluster> clusters = aggregateDemandClusters(stream, cellSize);
+			cout << "Demand clusters: " << clusters.size() << endl;
+			for (size_t k = 0; k < clusters.size() && k < 5; k++) {
+				cout << "Cluster " << k << ": (" << clusters[k].x << ", " << clusters[k].y << ") demand "
+					<< clusters[k].demand << ", customers " << clusters[k].customers << endl;
+			}
+
+			// Enumerate every non-empty open-facility vector x[i] and evaluate all of them in one pass
+			vector< vector<int> > openSolutions;
+			for (int mask = 1; mask < (1 << I); mask++) {
+				vector<int> x(I);
+				for (int i = 0; i < I; i++)
+					x[i] = (mask >> i) & 1;
+				openSolutions.push_back(x);
+			}
+
+			vector<FacilitySolutionCost> costs = evaluateOpenFacilities(stream, facilityX, facilityY, f, openSolutions, costPerDistance);
+
+			size_t best = 0;
+			for (size_t s = 0; s < costs.size(); s++) {
+				cout << "x[i]: ";
+				for (int i = 0; i < I; i++)
+					cout << openSolutions[s][i] << ",";
+				cout << " fixed " << costs[s].fixedCost << ", transport " << costs[s].transportCost
+					<< ", total " << costs[s].totalCost << endl;
+				if (costs[s].totalCost < costs[best].totalCost)
+					best = s;
+			}
+
+			cout << "\nBest open-facility solution: ";
+			for (int i = 0; i < I; i++)
+				cout << openSolutions[best][i] << ",";
+			cout << " with total cost " << costs[best].totalCost << endl;
+		}
+	}
+	remove(path.c_str());
+
+	cout << "\nPress [Enter] to continue..." << endl;
+	cin.get();    // used to stop console from closing
+}
+#pragma endregion
+
 // Creates Main method, entry point of C++ (int: returns integer)
 int main()
 {
@@ -365,6 +788,7 @@ int main()
 
 	capacitatedFacilityLocation(); 
 	uncapacitatedFacilityLocation();
+	streamingFacilityLocation();
 
 	return 0;
 }
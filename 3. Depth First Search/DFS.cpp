@@ -10,9 +10,13 @@
 
 // Libraries
 #include <algorithm>	// For range of elements, subsets of elements
+#include <atomic>		// Lock-free counters shared by threads
 #include <assert.h>		// Diagnostic messages and verify program assumptions
 #include <cmath>		// Perform math operations, sqrt(), log(), ...
+#include <cstdint>		// Fixed width integers, int64_t, ...
+#include <climits>		// Integer limits, INT_MAX, ...
 #include <cstdlib>		// General purpose function, abs(), ...
+#include <deque>		// Double-ended queues for work stealing
 #include <ctime>		// Converts time to character string
 #include <fstream>		// Open file for writing
 #include <ilcplex/ilocplex.h>	// CPLEX library
@@ -22,8 +26,28 @@
 #include <stdlib.h>		// Memory allocation, process control, conversion, ...
 #include <string>		// String manipulation
 #include <list>
+#include <memory>		// Shared ownership of mapped files
+#include <mutex>		// Mutual exclusion for shared results
 #include <vector>
 #include <stack>
+#include <thread>		// Worker threads for the parallel algorithms
+#include <utility>		// pair
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>	// AVX2 and SSSE3 intrinsics
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>		// Bit scan intrinsics
+#endif
+
+#ifdef _WIN32
+#include <windows.h>	// File mapping API, CreateFileMapping(), MapViewOfFile(), ...
+#else
+#include <fcntl.h>		// open()
+#include <sys/mman.h>	// Memory-mapped files, mmap(), munmap(), ...
+#include <sys/stat.h>	// File size, fstat()
+#include <unistd.h>		// close()
+#endif
 
 ILOSTLBEGIN // IBM macro to allow run the application in c++ with STL (Standard Template Library)
 
@@ -45,80 +69,429 @@ void AuthorDetails() {
 #define rowNumber 8
 #define colNumber 8
 
+/// <summary>
+///  Index of the lowest set bit of a non-zero word
+/// </summary>
+inline int lowestBit(uint64_t word)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+/// <summary>
+///  Splits [begin, end) into contiguous blocks and runs function(blockBegin, blockEnd) on one thread per block
+/// </summary>
+/// <param name="begin"> First index </param>
+/// <param name="end"> One past the last index </param>
+/// <param name="function"> Callable taking a (blockBegin, blockEnd) range </param>
+template <typename Function>
+void parallelFor(int begin, int end, Function function)
+{
+    int threadCount = (int)max(1u, thread::hardware_concurrency());
+    threadCount = min(threadCount, end - begin);
+    if (threadCount <= 1) {
+        if (begin < end)
+            function(begin, end);
+        return;
+    }
+
+    vector<thread> threads;
+    threads.reserve(threadCount);
+    for (int t = 0; t < threadCount; t++) {
+        int blockBegin = begin + (int)((int64_t)(end - begin) * t / threadCount);
+        int blockEnd = begin + (int)((int64_t)(end - begin) * (t + 1) / threadCount);
+        threads.push_back(thread(function, blockBegin, blockEnd));
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+}
+
+// Strongly connected components of a directed graph
+struct SCCResult
+{
+    // Number of strongly connected components
+    int componentCount;
+
+    // Component id of every vertex, ids are in reverse topological order (sink components first)
+    vector<int> componentOf;
+
+    // Vertices of component c are componentVertices[componentOffsets[c]], ..., componentVertices[componentOffsets[c + 1] - 1]
+    vector<int> componentOffsets;
+    vector<int> componentVertices;
+
+    // One directed cycle v0 -> v1 -> ... -> vk -> v0, empty if the graph is acyclic
+    vector<int> witnessCycle;
+};
+
+// Longest path of a directed acyclic graph
+struct LongestPathResult
+{
+    // False if a cycle was found, the longest path is then undefined
+    bool isDAG;
+
+    // Number of edges of the longest path
+    int length;
+
+    // Vertices of one longest path, in order
+    vector<int> path;
+
+    // Number of edges of the longest path ending at every vertex
+    vector<int> longestPathTo;
+};
+
+// Number of paths between two vertices of a directed acyclic graph
+struct PathCountResult
+{
+    // False if a cycle was found, the number of paths may then be infinite
+    bool isDAG;
+
+    // True if the count exceeded UINT64_MAX and was clamped to it
+    bool saturated;
+
+    // Number of paths
+    uint64_t count;
+};
+
+// Class for a read-only memory-mapped file, unmapped when the last owner releases it
+class MappedFile
+{
+#ifdef _WIN32
+    HANDLE file;        // File handle
+    HANDLE mapping;     // File mapping handle
+#else
+    int file;           // File descriptor
+#endif
+    const char* bytes;  // Mapped content
+    size_t length;      // File size in bytes
+
+    // The mapping owns OS handles, so it cannot be copied
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+public:
+
+    // Constructor, maps the whole file (data() is NULL on failure)
+    MappedFile(const string& path);
+
+    // Destructor, unmaps the file and closes it
+    ~MappedFile();
+
+    // Mapped content and its size
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+MappedFile::MappedFile(const string& path)
+{
+    bytes = NULL;
+    length = 0;
+
+#ifdef _WIN32
+    mapping = NULL;
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        return;
+
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+        return;
+
+    bytes = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (bytes != NULL)
+        length = (size_t)size.QuadPart;
+#else
+    file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return;
+
+    struct stat fileStatus;
+    if (fstat(file, &fileStatus) != 0 || fileStatus.st_size == 0)
+        return;
+
+    void* view = mmap(NULL, (size_t)fileStatus.st_size, PROT_READ, MAP_SHARED, file, 0);
+    if (view == MAP_FAILED)
+        return;
+
+    bytes = (const char*)view;
+    length = (size_t)fileStatus.st_size;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    if (bytes != NULL)
+        UnmapViewOfFile(bytes);
+    if (mapping != NULL)
+        CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE)
+        CloseHandle(file);
+#else
+    if (bytes != NULL)
+        munmap((void*)bytes, length);
+    if (file >= 0)
+        close(file);
+#endif
+}
+
+// Binary CSR snapshot: header, then int64 offsets[vertexCount + 1], then int32 targets[edgeCount]
+struct GraphSnapshotHeader
+{
+    char magic[8];          // File signature "WMGRAPH1"
+    int64_t vertexCount;    // Number of vertices
+    int64_t edgeCount;      // Number of edges
+};
+
+static const char graphSnapshotMagic[8] = { 'W', 'M', 'G', 'R', 'A', 'P', 'H', '1' };
+
 // Class for graph
 class Graph
 {
     // Nounmber of vertices
     int V;
 
-    // Pointer to an array containing adjacency list
-    list<int>* adj;
+    // Edges added since the last freeze, stored as (source, target) pairs
+    vector<pair<int, int> > pendingEdges;
 
-    // Pointer to an array containing adjacency vector
-    vector<int>* vec;
+    // Compressed sparse row (CSR) adjacency: the neighbors of v are
+    // targets[offsets[v]], ..., targets[offsets[v + 1] - 1] in insertion order
+    vector<int64_t> offsets;
+    vector<int> targets;
 
-    // Recursive check for cycles
-    bool isCycleRecursiveCheck(int v, bool visited[], int parent);
+    // Snapshot file the CSR arrays are read from in place (NULL if the arrays are owned)
+    shared_ptr<MappedFile> snapshot;
 
-    // Recursive DFS for mother vertex
-    void motherVecterDFS(int v, vector<bool>& visited);
+    // CSR arrays in use: the owned vectors or the mapped snapshot
+    const int64_t* offsetView;
+    const int* targetView;
+
+    // Points the views at the snapshot or at the owned vectors
+    void refreshViews();
+
+    // Explicit DFS stack frame: vertex and its next neighbor to explore
+    struct DFSFrame {
+        int v;
+        const int* next;
+    };
+
+    // Reusable DFS stack, preallocated with V frames (a DFS path never repeats a vertex)
+    vector<DFSFrame> frames;
 
-    // A recursive function used by printAllPaths()
-    void printPathsDFS(int, int, vector<bool>&, int[], int&);
+    // Iterative DFS for mother vertex
+    void motherVecterDFS(int v, vector<bool>& visited);
 
 public:
 
     // Constructor
     Graph(int V);
 
+    // Copies own their arrays or share the snapshot, so the views are rebuilt
+    Graph(const Graph& other);
+    Graph& operator=(const Graph& other);
+
+    // Moving keeps the vector buffers, so the views stay valid
+    Graph(Graph&& other) = default;
+    Graph& operator=(Graph&& other) = default;
+
+    // Number of vertices
+    int vertexCount() const { return V; }
+
+    // Number of edges (frozen and pending)
+    int64_t edgeCount() const { return offsetView[V] + (int64_t)pendingEdges.size(); }
+
+    // Moves pending edges into the CSR offsets and targets arrays
+    void freeze();
+
+    // First and one-past-last neighbor of v (valid after freeze)
+    const int* neighborsBegin(int v) const { return targetView + offsetView[v]; }
+    const int* neighborsEnd(int v) const { return targetView + offsetView[v + 1]; }
+
+    // Replaces the graph with the edges of a text edge list ("u v" per line, '#' starts a comment)
+    bool importEdgeList(const string& path);
+
+    // Writes the frozen graph as a binary CSR snapshot
+    bool saveSnapshot(const string& path);
+
+    // Replaces the graph with a memory-mapped snapshot, used in place without parsing
+    bool loadSnapshot(const string& path);
+
+    // Returns the graph with every edge reversed (frozen)
+    Graph transpose();
+
     // Add directed edge to graph as list
     void addUndirectedEdge(int v, int w);
 
     // Add undirected edge as list
     void addDirectedEdge(int v, int w);
 
-    // Add directed edge as vector
+    // Add directed edge as vector (same CSR storage as addDirectedEdge)
     void addDirectedEdgeVector(int v, int w);
 
-    // Returns true if there is a cycle
+    // Returns true if there is a directed cycle
     bool isCyclic();
 
+    // Iterative Tarjan strongly connected components with a witness cycle
+    SCCResult stronglyConnectedComponents();
+
+    // Returns all mother vertices of a graph in increasing order
+    vector<int> motherVertices();
+
     // Prints all mother vertices of a graph
     void findMother();
 
-    ///  Recursive DFS to print all paths from a source to a destination
+    ///  Prints all simple paths from a source to a destination, in batches from a PathEnumerator
     void printPaths(int s, int d);
 
+    ///  Number of paths from a source to a destination of a DAG (saturating count)
+    PathCountResult countPathsDAG(int s, int d);
+
     ///  Given a directed graph and a source, identify the DFS
     void graphDFS(int s);
 
-    ///  Recursive DFS to identify the longest path
+    ///  Iterative DFS to identify the longest path
     void longestPathDFS(int v, int longestPathPerNode[], bool visited[]);
+
+    ///  Longest path by dynamic programming over a Kahn topological order (level-synchronous threads if parallel)
+    LongestPathResult longestPathDAG(bool parallel = false);
 };
 
 Graph::Graph(int V)
 {
     this->V = V;
-    adj = new list<int>[V];
+    offsets.assign(V + 1, 0);
+    refreshViews();
+}
+
+Graph::Graph(const Graph& other) : V(other.V), pendingEdges(other.pendingEdges), offsets(other.offsets),
+    targets(other.targets), snapshot(other.snapshot), frames(other.frames)
+{
+    refreshViews();
+}
+
+Graph& Graph::operator=(const Graph& other)
+{
+    V = other.V;
+    pendingEdges = other.pendingEdges;
+    offsets = other.offsets;
+    targets = other.targets;
+    snapshot = other.snapshot;
+    frames = other.frames;
+    refreshViews();
+    return *this;
+}
+
+void Graph::refreshViews()
+{
+    if (snapshot) {
+        // Offsets follow the header, targets follow the offsets
+        offsetView = (const int64_t*)(snapshot->data() + sizeof(GraphSnapshotHeader));
+        targetView = (const int*)(offsetView + V + 1);
+    }
+    else {
+        offsetView = offsets.data();
+        targetView = targets.data();
+    }
+}
+
+/// <summary>
+///  Builds the CSR arrays from the frozen edges plus the pending edge list (counting sort by source)
+///  Insertion order of every adjacency list is kept, so traversals visit neighbors as before
+/// </summary>
+void Graph::freeze()
+{
+    // The DFS stack is sized on first use, so opening a snapshot allocates nothing per vertex
+    if (frames.size() < (size_t)V)
+        frames.resize(V);
+
+    if (pendingEdges.empty())
+        return;
+
+    // A mapped snapshot is read-only: copy it into owned arrays before adding edges
+    if (snapshot) {
+        offsets.assign(offsetView, offsetView + V + 1);
+        targets.assign(targetView, targetView + offsetView[V]);
+        snapshot.reset();
+    }
+
+    // Count the out-degree of every vertex
+    vector<int64_t> newOffsets(V + 1, 0);
+    for (int v = 0; v < V; v++)
+        newOffsets[v + 1] = offsets[v + 1] - offsets[v];
+    for (size_t e = 0; e < pendingEdges.size(); e++)
+        newOffsets[pendingEdges[e].first + 1]++;
+
+    // Prefix sum gives the first slot of every vertex
+    for (int v = 0; v < V; v++)
+        newOffsets[v + 1] += newOffsets[v];
+
+    // Frozen neighbors first, then pending edges in insertion order
+    vector<int> newTargets(newOffsets[V]);
+    vector<int64_t> slot(newOffsets.begin(), newOffsets.end() - 1);
+    for (int v = 0; v < V; v++)
+        for (int64_t e = offsets[v]; e < offsets[v + 1]; e++)
+            newTargets[slot[v]++] = targets[e];
+    for (size_t e = 0; e < pendingEdges.size(); e++)
+        newTargets[slot[pendingEdges[e].first]++] = pendingEdges[e].second;
+
+    offsets.swap(newOffsets);
+    targets.swap(newTargets);
+    vector<pair<int, int> >().swap(pendingEdges);  // Release the edge list memory
+    refreshViews();
+}
+
+/// <summary>
+///  Builds the reverse graph, the neighbors of v in it are the predecessors of v
+/// </summary>
+Graph Graph::transpose()
+{
+    freeze();
+
+    Graph reverse(V);
+    reverse.targets.resize(offsetView[V]);
+
+    // Count in-degrees and prefix sum them into offsets
+    for (int64_t e = 0; e < offsetView[V]; e++)
+        reverse.offsets[targetView[e] + 1]++;
+    for (int v = 0; v < V; v++)
+        reverse.offsets[v + 1] += reverse.offsets[v];
+
+    // Sources are scanned in increasing order, so predecessor lists are sorted
+    vector<int64_t> slot(reverse.offsets.begin(), reverse.offsets.end() - 1);
+    for (int v = 0; v < V; v++)
+        for (const int* i = neighborsBegin(v); i != neighborsEnd(v); ++i)
+            reverse.targets[slot[*i]++] = v;
+
+    reverse.refreshViews();
+    reverse.freeze();   // Sizes its DFS stack
+    return reverse;
 }
 
 void Graph::addUndirectedEdge(int v, int w)
 {
     // Add w to vs list.
-    adj[v].push_back(w);
+    pendingEdges.push_back(make_pair(v, w));
 
     // Add v to ws list.
-    adj[w].push_back(v);
+    pendingEdges.push_back(make_pair(w, v));
 }
 
 void Graph::addDirectedEdge(int v, int w)
 {
-    adj[v].push_back(w); // Add w to vs list.
+    pendingEdges.push_back(make_pair(v, w)); // Add w to vs list.
 }
 
 void Graph::addDirectedEdgeVector(int v, int w)
 {
-    vec[v].push_back(w); // Add w to vs list.
+    addDirectedEdge(v, w); // Add w to vs list.
 }
 
 #pragma endregion
@@ -131,6 +504,7 @@ void Graph::addDirectedEdgeVector(int v, int w)
 /// <param name="source"> Source node </param>
 void Graph::graphDFS(int source)
 {
+    freeze();                        // Build CSR arrays from pending edges
     vector<bool> visited(V, false);  // Initialze visited vector in False
     stack<int> dfsNodes;    // Stack to store the nodes of the DFS
 
@@ -146,8 +520,7 @@ void Graph::graphDFS(int source)
         }
 
         // Loop in adjacent node list and push (add on top) if not visited
-        list<int>::iterator i;
-        for (i = adj[source].begin(); i != adj[source].end(); ++i)
+        for (const int* i = neighborsBegin(source); i != neighborsEnd(source); ++i)
             if (!visited[*i])
                 dfsNodes.push(*i);
     }
@@ -187,54 +560,199 @@ void graphDFS(int source)
 
 #pragma region Print All Paths from Source to Destination
 
+// Paths returned by one PathEnumerator batch: path p is vertices[offsets[p]], ..., vertices[offsets[p + 1] - 1]
+struct PathBatch
+{
+    vector<int> vertices;
+    vector<int> offsets;
+
+    // Number of paths in the batch
+    int size() const { return offsets.empty() ? 0 : (int)offsets.size() - 1; }
+};
+
+// Class for lazily enumerating the simple paths from a source to a destination
+// The DFS state lives in the enumerator, so the caller pulls paths in batches and can stop at any time
+// The enumerator keeps pointers into the CSR arrays: the graph must not get new edges or be frozen
+// again while an enumerator is alive
+class PathEnumerator
+{
+    // Graph being enumerated (frozen by the constructor)
+    Graph& g;
+
+    // Source, destination and maximum number of edges of a path
+    int source, destination, maxDepth;
+
+    // Current path and the next neighbor to explore from each of its vertices (pointers into the CSR arrays)
+    vector<int> pathVertex;
+    vector<const int*> pathNext;
+
+    // True for vertices on the current path
+    vector<char> onPath;
+
+    // Enumeration state
+    bool started, finished;
+
+    // Appends v to the current path, returns true if it is the destination
+    bool push(int v);
+
+public:
+
+    // Constructor, maxDepth bounds the number of edges of the enumerated paths
+    PathEnumerator(Graph& g, int source, int destination, int maxDepth = INT_MAX);
+
+    // Replaces the content of batch with up to maxPaths further paths, returns the number of paths written
+    int nextBatch(PathBatch& batch, int maxPaths);
+
+    // Returns true once every path has been returned
+    bool done() const { return finished; }
+};
+
+PathEnumerator::PathEnumerator(Graph& g, int source, int destination, int maxDepth) : g(g)
+{
+    g.freeze();   // Build CSR arrays from pending edges
+    this->source = source;
+    this->destination = destination;
+    this->maxDepth = maxDepth;
+    onPath.assign(g.vertexCount(), 0);
+    started = false;
+    finished = false;
+}
+
+bool PathEnumerator::push(int v)
+{
+    onPath[v] = 1;
+    pathVertex.push_back(v);
+
+    // A path ends at the destination, so its neighbors are not explored
+    pathNext.push_back(v == destination ? g.neighborsEnd(v) : g.neighborsBegin(v));
+    return v == destination;
+}
+
 /// <summary>
-///  Recursive DFS to print all paths from a source to a destination
+///  Resumes the iterative DFS until maxPaths paths are found or the enumeration ends
 /// </summary>
-/// <param name="source"> Source node </param>
-/// <param name="destination"> Destintion node </param>
-void Graph::printPathsDFS(int source, int destination, vector<bool>& visited, int path[], int& indexPath)
+/// <param name="batch"> Caller-supplied buffer, cleared and refilled (its capacity is reused) </param>
+/// <param name="maxPaths"> Maximum number of paths to return </param>
+/// </return> Returns the number of paths written to the batch
+int PathEnumerator::nextBatch(PathBatch& batch, int maxPaths)
 {
-    // Mark the current node and store it in path[]
-    visited[source] = true;
-    path[indexPath] = source;
-    indexPath++;
+    batch.vertices.clear();
+    batch.offsets.assign(1, 0);
+    int found = 0;
 
-    // End of recursion for a path, case source is destination 
-    if (source == destination) {
-        for (int i = 0; i < indexPath; i++)
-            cout << path[i] << " ";     // Print saved path
-        cout << endl;
-    }
-    else // If current vertex is not destination
-    {
-        // Recursion for all adjacent nodes
-        list<int>::iterator i;
-        for (i = adj[source].begin(); i != adj[source].end(); ++i)
-            if (!visited[*i])
-                printPathsDFS(*i, destination, visited, path, indexPath);
-    }
+    while (!finished && found < maxPaths) {
+        bool complete = false;
+
+        if (!started) {
+            started = true;
+            complete = push(source);
+        }
+        else if (pathVertex.empty()) {
+            finished = true;
+            break;
+        }
+        else if (pathNext.back() == g.neighborsEnd(pathVertex.back())) {
+            // Backtrack, every neighbor was explored
+            onPath[pathVertex.back()] = 0;
+            pathVertex.pop_back();
+            pathNext.pop_back();
+            continue;
+        }
+        else {
+            // Descend into the next neighbor not on the path, within the depth bound
+            int w = *pathNext.back()++;
+            if (!onPath[w] && (int)pathVertex.size() <= maxDepth)
+                complete = push(w);
+        }
 
-    // Reverse parameters for DFS considering next adjacent node
-    indexPath--;
-    visited[source] = false;
+        if (complete) {
+            batch.vertices.insert(batch.vertices.end(), pathVertex.begin(), pathVertex.end());
+            batch.offsets.push_back((int)batch.vertices.size());
+            found++;
+        }
+    }
+    return found;
 }
 
 /// <summary>
 /// Given a source, a destination and a directed graph, print all their paths
-/// Initialize path and call recursive DFS
+/// Paths are pulled in batches and written without flushing the stream for every path
 /// </summary>
 /// <param name="source"> Source node </param>
 /// <param name="destination"> Destintion node </param>
 void Graph::printPaths(int source, int destination)
 {
-    vector <bool> visited(V, false);  // Visited node vector initialized as false
+    PathEnumerator paths(*this, source, destination);
+    PathBatch batch;
+
+    while (paths.nextBatch(batch, 1024) > 0) {
+        for (int p = 0; p < batch.size(); p++) {
+            for (int i = batch.offsets[p]; i < batch.offsets[p + 1]; i++)
+                cout << batch.vertices[i] << " ";     // Print saved path
+            cout << '\n';
+        }
+    }
+    cout.flush();
+}
+
+/// <summary>
+///  Counts the paths from a source to a destination of a DAG in O(V + E)
+///  paths[v] is the number of paths from the source to v, accumulated in Kahn topological order.
+///  Counts saturate at UINT64_MAX instead of overflowing
+/// </summary>
+/// <param name="source"> Source node </param>
+/// <param name="destination"> Destintion node </param>
+PathCountResult Graph::countPathsDAG(int source, int destination)
+{
+    freeze();   // Build CSR arrays from pending edges
+
+    PathCountResult result;
+    result.isDAG = false;
+    result.saturated = false;
+    result.count = 0;
+
+    vector<int> inDegree(V, 0);
+    for (int v = 0; v < V; v++)
+        for (const int* i = neighborsBegin(v); i != neighborsEnd(v); ++i)
+            inDegree[*i]++;
+
+    vector<int> order;
+    order.reserve(V);
+    for (int v = 0; v < V; v++)
+        if (inDegree[v] == 0)
+            order.push_back(v);
+
+    vector<uint64_t> paths(V, 0);
+    paths[source] = 1;
+
+    // True if paths[v] was clamped, here or at a vertex before v
+    vector<char> saturated(V, 0);
+
+    for (size_t head = 0; head < order.size(); head++) {
+        int u = order[head];
+        for (const int* i = neighborsBegin(u); i != neighborsEnd(u); ++i) {
+            // Saturating addition
+            if (paths[*i] > UINT64_MAX - paths[u]) {
+                paths[*i] = UINT64_MAX;
+                saturated[*i] = 1;
+            }
+            else
+                paths[*i] += paths[u];
+            saturated[*i] |= saturated[u];
+
+            if (--inDegree[*i] == 0)
+                order.push_back(*i);
+        }
+    }
 
-    // Create an array to store paths
-    int* path = new int[V];
-    int indexPath = 0;
+    // Vertices left out of the order lie on or behind a cycle
+    if ((int)order.size() < V)
+        return result;
 
-    // Recursive functions for DFS
-    printPathsDFS(source, destination, visited, path, indexPath);
+    result.isDAG = true;
+    result.saturated = saturated[destination] != 0;
+    result.count = paths[destination];
+    return result;
 }
 
 /// <summary>
@@ -267,6 +785,39 @@ void printPathSourceDestination(int source, int destination)
     cout << "Following are all different paths from " << source << " to " << destination << endl;
     g.printPaths(source, destination);
 
+    // Directed acyclic graph for counting and lazy enumeration
+    int edgesDAG[][2] = { {0,1},
+                          {0,2},
+                          {1,3},
+                          {2,3},
+                          {3,4},
+                          {3,5},
+                          {4,6},
+                          {5,6},
+                          {6,7} };
+
+    Graph dag(colNumber);
+
+    cout << "\nThe following directed acyclic graph example is used:" << endl;
+    for (size_t i = 0; i < size(edgesDAG); i++) {
+        cout << edgesDAG[i][0] << " " << edgesDAG[i][1] << endl;
+        dag.addDirectedEdge(edgesDAG[i][0], edgesDAG[i][1]);     //Saves edge into graph
+    }
+
+    PathCountResult count = dag.countPathsDAG(0, 7);
+    cout << "Number of paths from 0 to 7: " << count.count << (count.saturated ? " (saturated)" : "") << endl;
+
+    // Pull the paths two at a time and stop after the first batch
+    PathEnumerator paths(dag, 0, 7);
+    PathBatch batch;
+    paths.nextBatch(batch, 2);
+    cout << "First batch of " << batch.size() << " paths:" << endl;
+    for (int p = 0; p < batch.size(); p++) {
+        for (int i = batch.offsets[p]; i < batch.offsets[p + 1]; i++)
+            cout << batch.vertices[i] << " ";
+        cout << endl;
+    }
+
     cout << "\nPress [Enter] to continue..." << endl;
     cin.get();    // used to stop console from closing
 
@@ -284,35 +835,76 @@ void Graph::motherVecterDFS(int v, vector<bool>& visited)
 {
     visited[v] = true;
 
-    list<int>::iterator i;
-    for (i = adj[v].begin(); i != adj[v].end(); ++i)
-        if (!visited[*i])
-            motherVecterDFS(*i, visited);
+    // Explicit stack of (vertex, next neighbor) frames
+    int top = 0;
+    frames[0].v = v;
+    frames[0].next = neighborsBegin(v);
+
+    while (top >= 0) {
+        DFSFrame& frame = frames[top];
+        if (frame.next == neighborsEnd(frame.v)) {
+            top--;   // All neighbors explored
+            continue;
+        }
+
+        int w = *frame.next++;
+        if (!visited[w]) {
+            visited[w] = true;
+            frames[++top].v = w;
+            frames[top].next = neighborsBegin(w);
+        }
+    }
 }
 
 /// <summary>
-///  Find and prints mother vertices of a graph
+///  Finds all mother vertices of a graph in O(V + E)
+///  A DFS forest is grown over all vertices; if a mother vertex exists, the root of the last tree is one.
+///  The mother vertices are then the source component of the SCC condensation, i.e. every vertex
+///  that can reach the candidate, found with one DFS on the reverse graph
 /// </summary>
-void Graph::findMother()
-{   
+/// </return> Returns the mother vertices in increasing order (empty if there is none)
+vector<int> Graph::motherVertices()
+{
+    freeze();                         // Build CSR arrays from pending edges
     vector <bool> visited(V, false);  // Visited node vector
     vector <int> mother;              // Vector to store mother vertices
-    bool isMother;                       
+    int candidate = -1;
 
-    // Loop through all vertices
+    // Loop through all vertices, the last DFS root is the only possible candidate
     for (int i = 0; i < V; i++)
     {
-        fill(visited.begin(), visited.end(), false);  //Initiate visited as purely false
-        motherVecterDFS(i, visited);     // Recursive DFS
-        isMother = true;
-        for (int j = 0; j < V; j++)   // Check is vertex is mother
-            if (visited[j] == false)
-                isMother = false;
-
-        if (isMother) {          // Add mother vertex
-            mother.push_back(i);
+        if (!visited[i]) {
+            motherVecterDFS(i, visited);     // Iterative DFS
+            candidate = i;
         }
     }
+    if (candidate < 0)
+        return mother;
+
+    // Verify that the candidate reaches every vertex
+    fill(visited.begin(), visited.end(), false);  //Initiate visited as purely false
+    motherVecterDFS(candidate, visited);
+    for (int j = 0; j < V; j++)   // Check is vertex is mother
+        if (visited[j] == false)
+            return mother;
+
+    // Every vertex that reaches the candidate is a mother vertex
+    Graph reverse = transpose();
+    fill(visited.begin(), visited.end(), false);
+    reverse.motherVecterDFS(candidate, visited);
+    for (int j = 0; j < V; j++)
+        if (visited[j])          // Add mother vertex
+            mother.push_back(j);
+
+    return mother;
+}
+
+/// <summary>
+///  Find and prints mother vertices of a graph
+/// </summary>
+void Graph::findMother()
+{   
+    vector <int> mother = motherVertices();  // Vector to store mother vertices
 
     // Prints mother vertices
     cout << "Number of mother vertices: " << mother.size() << endl;
@@ -355,25 +947,159 @@ void motherVertex()
 
 #pragma region Longest Path in Graph
 
+// Prints the strongly connected components and the witness cycle of a graph (Detect Cycle region)
+void printCycleWitness(Graph& g);
+
+/// <summary>
+///  Longest path by dynamic programming over a topological order from Kahn algorithm
+///  In parallel mode the DAG is processed level by level: the vertices of a level pull their value
+///  from their predecessors (all in earlier levels) in parallel, and the next level is collected with
+///  atomic in-degree counters. This pays off on wide DAGs, where levels hold many vertices
+/// </summary>
+/// <param name="parallel"> Use the multi-threaded level-synchronous mode </param>
+/// </return> Returns the longest path, isDAG is false if a cycle is found
+LongestPathResult Graph::longestPathDAG(bool parallel)
+{
+    freeze();   // Build CSR arrays from pending edges
+
+    LongestPathResult result;
+    result.isDAG = false;
+    result.length = 0;
+    result.longestPathTo.assign(V, 0);
+    vector<int> parent(V, -1);     // Predecessor on the longest path ending at v
+    int processed = 0;             // Number of vertices taken out of the Kahn queue
+
+    // In-degree of every vertex
+    vector<atomic<int> > inDegree(V);
+    for (int v = 0; v < V; v++)
+        inDegree[v].store(0, memory_order_relaxed);
+    for (int v = 0; v < V; v++)
+        for (const int* i = neighborsBegin(v); i != neighborsEnd(v); ++i)
+            inDegree[*i].fetch_add(1, memory_order_relaxed);
+
+    // First level: vertices without predecessors
+    vector<int> frontier;
+    for (int v = 0; v < V; v++)
+        if (inDegree[v].load(memory_order_relaxed) == 0)
+            frontier.push_back(v);
+
+    if (!parallel) {
+        // Kahn queue, each vertex pushes its value to its successors
+        for (size_t head = 0; head < frontier.size(); head++) {
+            int u = frontier[head];
+            for (const int* i = neighborsBegin(u); i != neighborsEnd(u); ++i) {
+                if (result.longestPathTo[u] + 1 > result.longestPathTo[*i]) {
+                    result.longestPathTo[*i] = result.longestPathTo[u] + 1;
+                    parent[*i] = u;
+                }
+                if (inDegree[*i].fetch_sub(1, memory_order_relaxed) == 1)
+                    frontier.push_back(*i);
+            }
+        }
+        processed = (int)frontier.size();
+    }
+    else {
+        Graph reverse = transpose();
+        mutex nextMutex;
+        vector<int> next;
+
+        while (!frontier.empty()) {
+            processed += (int)frontier.size();
+            next.clear();
+
+            // Small levels are not worth the threads
+            auto processLevel = [&](int begin, int end) {
+                vector<int> localNext;
+                for (int k = begin; k < end; k++) {
+                    int v = frontier[k];
+
+                    // Pull the best predecessor, all of them are in earlier levels
+                    for (const int* i = reverse.neighborsBegin(v); i != reverse.neighborsEnd(v); ++i) {
+                        if (result.longestPathTo[*i] + 1 > result.longestPathTo[v]) {
+                            result.longestPathTo[v] = result.longestPathTo[*i] + 1;
+                            parent[v] = *i;
+                        }
+                    }
+
+                    // A successor joins the next level when its last predecessor is done
+                    for (const int* i = neighborsBegin(v); i != neighborsEnd(v); ++i)
+                        if (inDegree[*i].fetch_sub(1, memory_order_acq_rel) == 1)
+                            localNext.push_back(*i);
+                }
+                lock_guard<mutex> lock(nextMutex);
+                next.insert(next.end(), localNext.begin(), localNext.end());
+            };
+
+            if (frontier.size() < 4096)
+                processLevel(0, (int)frontier.size());
+            else
+                parallelFor(0, (int)frontier.size(), processLevel);
+
+            frontier.swap(next);
+        }
+    }
+
+    // Vertices left out of the order lie on or behind a cycle
+    if (processed < V)
+        return result;
+    result.isDAG = true;
+
+    // Rebuild the path backwards from the vertex with the longest path
+    int last = 0;
+    for (int v = 1; v < V; v++)
+        if (result.longestPathTo[v] > result.longestPathTo[last])
+            last = v;
+    if (V > 0) {
+        result.length = result.longestPathTo[last];
+        for (int v = last; v >= 0; v = parent[v])
+            result.path.push_back(v);
+        reverse(result.path.begin(), result.path.end());
+    }
+    return result;
+}
+
 /// <summary>
-///  Recursive DFS to identify the longest path
+///  Iterative DFS (explicit stack) to identify the longest path
 /// </summary>
 /// <param name="v"> Node to be checked </param>
 /// <param name="parent"> Specified parent of the node </param>
 /// <param name="visvisitedited"> Visited node array </param>
 void Graph::longestPathDFS(int v, int longestPathPerNode[], bool visited[])
 {
+    freeze();   // Build CSR arrays from pending edges (no-op once frozen)
+
     // Mark as visited
     visited[v] = true;
 
-    list<int>::iterator i;
-    for (i = adj[v].begin(); i != adj[v].end(); ++i) {
-
-        if (!visited[*i])
-            longestPathDFS(*i, longestPathPerNode, visited);
+    // A frame keeps pointing at the child being explored until that child is finished
+    int top = 0;
+    frames[0].v = v;
+    frames[0].next = neighborsBegin(v);
+
+    while (top >= 0) {
+        DFSFrame& frame = frames[top];
+        if (frame.next == neighborsEnd(frame.v)) {
+            // Vertex finished: the parent stores the longest path through it
+            top--;
+            if (top >= 0) {
+                DFSFrame& parent = frames[top];
+                longestPathPerNode[parent.v] = max(longestPathPerNode[parent.v], 1 + longestPathPerNode[frame.v]);
+                parent.next++;
+            }
+            continue;
+        }
 
-        // Store the longest paths
-        longestPathPerNode[v] = max(longestPathPerNode[v], 1 + longestPathPerNode[*i]);
+        int w = *frame.next;
+        if (!visited[w]) {
+            visited[w] = true;
+            frames[++top].v = w;
+            frames[top].next = neighborsBegin(w);
+        }
+        else {
+            // Store the longest paths
+            longestPathPerNode[frame.v] = max(longestPathPerNode[frame.v], 1 + longestPathPerNode[w]);
+            frame.next++;
+        }
     }
 }
 
@@ -405,7 +1131,7 @@ void longestPath()
     bool visitedArray[rowNumber];                    // Create and initialize visited array in FALSE
     memset(visitedArray, false, sizeof visitedArray);
 
-    // Recursive DFS for longest path
+    // Iterative DFS for longest path
     for (int i = 0; i < rowNumber; i++) {
         if (!visitedArray[i])
             g.longestPathDFS(i, longestPathPerNode, visitedArray);
@@ -414,10 +1140,27 @@ void longestPath()
     int longestPathGraph = 0;
 
     // Loop to identify the longest path from all of them
-    for (int i = 1; i <= rowNumber; i++) {
+    for (int i = 0; i < rowNumber; i++) {
         longestPathGraph = max(longestPathGraph, longestPathPerNode[i]);
     }
-    cout << "The longest path in the graph is: " << longestPathGraph;
+    cout << "The longest path in the graph is: " << longestPathGraph << endl;
+
+    // Topological order DP, also reports the path itself
+    LongestPathResult sequential = g.longestPathDAG();
+    LongestPathResult levels = g.longestPathDAG(true);
+    cout << "Longest path from topological order DP (" << sequential.length << " edges): ";
+    for (size_t i = 0; i < sequential.path.size(); i++)
+        cout << sequential.path[i] << " ";
+    cout << endl;
+    cout << "Level-synchronous parallel DP length: " << levels.length << endl;
+
+    // Closing a cycle makes the longest path undefined
+    g.addDirectedEdge(7, 5);
+    cout << "After adding edge 7 5: ";
+    if (!g.longestPathDAG().isDAG) {
+        cout << "graph contains a cycle, longest path is undefined" << endl;
+        printCycleWitness(g);
+    }
 
     cout << "\nPress [Enter] to continue..." << endl;
     cin.get();    // used to stop console from closing
@@ -428,29 +1171,98 @@ void longestPath()
 #pragma region Detect Cycle in Directed Graph
 
 /// <summary>
-///  Recursive check for cycles in a graph
+///  Iterative Tarjan algorithm with tri-colour marking, one O(V + E) pass
+///  WHITE vertices are unvisited, GRAY vertices are on the current DFS path and BLACK vertices are finished.
+///  An edge into a GRAY vertex closes a directed cycle, which is kept as witness.
+///  All per-vertex state lives in one workspace allocated once, the DFS path reuses the frames stack
 /// </summary>
-/// <param name="v"> Node to be checked </param>
-/// <param name="visited"> Visited node array </param>
-/// <param name="parent"> Specified parent of the node </param>
-bool Graph::isCycleRecursiveCheck(int v, bool visited[], int parent)
+/// </return> Returns the components (reverse topological order) and a witness cycle
+SCCResult Graph::stronglyConnectedComponents()
 {
-    // Update visited node
-    visited[v] = true;
+    freeze();   // Build CSR arrays from pending edges
+
+    const char WHITE = 0, GRAY = 1, BLACK = 2;
+
+    // Single workspace: discovery index, low link and Tarjan stack (3V ints) plus colours (V chars)
+    vector<int> workspace(3 * (size_t)V);
+    int* index = workspace.data();
+    int* lowLink = index + V;
+    int* sccStack = lowLink + V;
+    vector<char> colour(V, WHITE);
+
+    SCCResult result;
+    result.componentCount = 0;
+    result.componentOf.assign(V, -1);
+    result.componentOffsets.reserve(V + 1);
+    result.componentOffsets.push_back(0);
+    result.componentVertices.reserve(V);
+
+    int counter = 0;     // Next discovery index
+    int sccTop = -1;     // Top of the Tarjan stack
+
+    for (int root = 0; root < V; root++) {
+        if (colour[root] != WHITE)
+            continue;
+
+        // Push root on the DFS path
+        int top = 0;
+        frames[0].v = root;
+        frames[0].next = neighborsBegin(root);
+        index[root] = lowLink[root] = counter++;
+        colour[root] = GRAY;
+        sccStack[++sccTop] = root;
+
+        while (top >= 0) {
+            DFSFrame& frame = frames[top];
+            int v = frame.v;
+
+            if (frame.next != neighborsEnd(v)) {
+                int w = *frame.next++;
+
+                if (colour[w] == WHITE) {
+                    // Tree edge, descend into w
+                    frames[++top].v = w;
+                    frames[top].next = neighborsBegin(w);
+                    index[w] = lowLink[w] = counter++;
+                    colour[w] = GRAY;
+                    sccStack[++sccTop] = w;
+                }
+                else if (result.componentOf[w] < 0) {
+                    // w is still on the Tarjan stack, so it is in the SCC of an ancestor
+                    lowLink[v] = min(lowLink[v], index[w]);
+
+                    // Back edge into the DFS path: the path from w to v plus (v, w) is a cycle
+                    if (colour[w] == GRAY && result.witnessCycle.empty()) {
+                        int position = top;
+                        while (frames[position].v != w)
+                            position--;
+                        for (int i = position; i <= top; i++)
+                            result.witnessCycle.push_back(frames[i].v);
+                    }
+                }
+                continue;
+            }
 
-    // List iterator
-    list<int>::iterator i;
+            // v is finished, pop its component if it is the root of one
+            colour[v] = BLACK;
+            if (lowLink[v] == index[v]) {
+                int w;
+                do {
+                    w = sccStack[sccTop--];
+                    result.componentOf[w] = result.componentCount;
+                    result.componentVertices.push_back(w);
+                } while (w != v);
+                result.componentOffsets.push_back((int)result.componentVertices.size());
+                result.componentCount++;
+            }
 
-    // Loop for adjacent nodes list
-    for (i = adj[v].begin(); i != adj[v].end(); ++i){
-        if (!visited[*i]){
-            if (isCycleRecursiveCheck(*i, visited, v))
-                return true;
+            // Return to the parent frame
+            top--;
+            if (top >= 0)
+                lowLink[frames[top].v] = min(lowLink[frames[top].v], lowLink[v]);
         }
-        else if (*i != parent)
-            return true;
     }
-    return false;
+    return result;
 }
 
 /// <summary>
@@ -458,20 +1270,34 @@ bool Graph::isCycleRecursiveCheck(int v, bool visited[], int parent)
 /// </summary>
 bool Graph::isCyclic()
 {
-    // Bool pointer array for visited nodes
-    bool* visited = new bool[V];
+    // A directed graph has a cycle iff Tarjan finds an edge into the DFS path (self-loops included)
+    return !stronglyConnectedComponents().witnessCycle.empty();
+}
 
-    // Start with 0 visited nodes
-    for (int v = 0; v < V; v++)
-        visited[v] = false;
+/// <summary>
+///  Prints the strongly connected components and the witness cycle of a graph
+/// </summary>
+/// <param name="g"> Directed graph </param>
+void printCycleWitness(Graph& g)
+{
+    SCCResult scc = g.stronglyConnectedComponents();
+
+    cout << "Strongly connected components: " << scc.componentCount << endl;
+    for (int c = 0; c < scc.componentCount; c++) {
+        if (scc.componentOffsets[c + 1] - scc.componentOffsets[c] < 2)
+            continue;   // Only components with more than one vertex are printed
+        cout << "Component " << c << ": ";
+        for (int i = scc.componentOffsets[c]; i < scc.componentOffsets[c + 1]; i++)
+            cout << scc.componentVertices[i] << " ";
+        cout << endl;
+    }
 
-    for (int v = 0; v < V; v++){
-        if (!visited[v])
-            // Initialize recursive check with parent -1
-            if (isCycleRecursiveCheck(v, visited, -1))
-                return true;
+    if (!scc.witnessCycle.empty()) {
+        cout << "Witness cycle: ";
+        for (size_t i = 0; i < scc.witnessCycle.size(); i++)
+            cout << scc.witnessCycle[i] << " -> ";
+        cout << scc.witnessCycle[0] << endl;
     }
-    return false;
 }
 
 /// <summary>
@@ -503,6 +1329,8 @@ void detectCycleDirectedGraph()
     gA.isCyclic() ?
         cout << "Graph contains cycle\n" << endl :
         cout << "Graph doesn't contain cycle\n" << endl;
+    printCycleWitness(gA);
+    cout << endl;
 
     // Display used cycle graph example
     int edgesB[][2] = {{0,1},
@@ -525,6 +1353,7 @@ void detectCycleDirectedGraph()
     gB.isCyclic() ?
         cout << "Graph contains cycle\n" << endl :
         cout << "Graph doesn't contain cycle\n" << endl;
+    printCycleWitness(gB);
 
     cout << "\nPress [Enter] to continue..." << endl;
     cin.get();    // used to stop console from closing
@@ -534,6 +1363,97 @@ void detectCycleDirectedGraph()
 
 #pragma region Transitive Closure
 
+// Class for a square boolean matrix stored as rows of 64-bit words (32 times smaller than an int matrix)
+class BitMatrix
+{
+    // Number of rows and columns
+    int n;
+
+    // Words per row, padded to a multiple of 4 so rows can be processed as 256-bit vectors
+    int wordsPerRow;
+
+    // Row-major bits, bit j of row i is word j / 64, bit j % 64
+    vector<uint64_t> bits;
+
+public:
+
+    // Constructor, all entries start as 0
+    BitMatrix(int n) : n(n), wordsPerRow(((n + 63) / 64 + 3) / 4 * 4), bits((size_t)n * wordsPerRow, 0) {}
+
+    // Number of rows and columns
+    int size() const { return n; }
+
+    // Number of 64-bit words per row
+    int rowWords() const { return wordsPerRow; }
+
+    // Access to row i
+    uint64_t* row(int i) { return bits.data() + (size_t)i * wordsPerRow; }
+    const uint64_t* row(int i) const { return bits.data() + (size_t)i * wordsPerRow; }
+
+    // Entry (i, j)
+    bool get(int i, int j) const { return (row(i)[j >> 6] >> (j & 63)) & 1; }
+    void set(int i, int j) { row(i)[j >> 6] |= (uint64_t)1 << (j & 63); }
+};
+
+/// <summary>
+///  Target row |= source row, four words per instruction with AVX2
+/// </summary>
+/// <param name="target"> Row updated in place </param>
+/// <param name="source"> Row OR-ed into target </param>
+/// <param name="words"> Number of words (multiple of 4) </param>
+inline void orRow(uint64_t* target, const uint64_t* source, int words)
+{
+#ifdef __AVX2__
+    for (int w = 0; w < words; w += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(target + w));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(source + w));
+        _mm256_storeu_si256((__m256i*)(target + w), _mm256_or_si256(a, b));
+    }
+#else
+    for (int w = 0; w < words; w++)
+        target[w] |= source[w];
+#endif
+}
+
+/// <summary>
+///  Transitive closure of a bit matrix (Warshall algorithm on whole rows, blocked by 64 pivots)
+///  For each block of 64 pivots k, the block rows are closed first; every other row i then ORs
+///  row k into row i whenever bit (i, k) is set. The 64 pivot rows stay in cache while all
+///  rows stream past them, and the non-pivot rows are updated in parallel
+/// </summary>
+/// <param name="matrix"> Adjacency matrix, replaced by its transitive closure </param>
+void bitTransitiveClosure(BitMatrix& matrix)
+{
+    const int n = matrix.size();
+    const int words = matrix.rowWords();
+
+    for (int blockBegin = 0; blockBegin < n; blockBegin += 64) {
+        const int blockEnd = min(blockBegin + 64, n);
+        const int pivotWord = blockBegin >> 6;
+
+        // Pivot rows of the block, sequential Warshall restricted to the block
+        for (int k = blockBegin; k < blockEnd; k++) {
+            const uint64_t* rowK = matrix.row(k);
+            for (int i = blockBegin; i < blockEnd; i++)
+                if (i != k && matrix.get(i, k))
+                    orRow(matrix.row(i), rowK, words);
+        }
+
+        // Every other row only reads the (now final) pivot rows, so rows are independent
+        parallelFor(0, n, [&matrix, words, blockBegin, blockEnd, pivotWord](int rowBegin, int rowEnd) {
+            for (int i = rowBegin; i < rowEnd; i++) {
+                if (i >= blockBegin && i < blockEnd)
+                    continue;
+                uint64_t* rowI = matrix.row(i);
+                // The pivot word is re-read, OR-ing row k may set later pivots of the same block
+                for (int k = blockBegin; k < blockEnd; k++)
+                    if ((rowI[pivotWord] >> (k & 63)) & 1)
+                        orRow(rowI, matrix.row(k), words);
+            }
+        });
+    }
+}
+
 /// <summary>
 ///  Given an adjacency matrix, uses Floyd Warshall algorithm to identify the transitive closure
 /// </summary>
@@ -587,9 +1507,25 @@ void transitiveClosure()
         } cout << endl;
     }
 
+    // Bit-packed copy of the adjacency matrix for the blocked closure engine
+    BitMatrix bitMatrix(rowNumber);
+    for (int i = 0; i < rowNumber; i++)
+        for (int j = 0; j < colNumber; j++)
+            if (adjacencyMatrix[i][j])
+                bitMatrix.set(i, j);
+
     // Identify the transitive closure
     transitiveClosure(adjacencyMatrix);
 
+    // Same closure with the bit-packed engine
+    bitTransitiveClosure(bitMatrix);
+    bool sameClosure = true;
+    for (int i = 0; i < rowNumber; i++)
+        for (int j = 0; j < colNumber; j++)
+            if (bitMatrix.get(i, j) != (adjacencyMatrix[i][j] != 0))
+                sameClosure = false;
+    cout << "Bit-packed closure engine gives the same closure: " << (sameClosure ? "yes" : "no") << endl;
+
     cout << "\nPress [Enter] to continue..." << endl;
     cin.get();    // used to stop console from closing
 }
@@ -621,16 +1557,266 @@ void DFS(int matrix[][colNumber], bool visitedMatrix[][colNumber], int cellRow,
     static int neighborRow[] = { -1, -1, -1, 0, 0, 1, 1, 1 };
     static int neighborCol[] = { -1, 0, 1, -1, 1, -1, 0, 1 };
 
+    // Explicit stack frame: cell and its next neighbor to check
+    struct CellFrame {
+        int row;
+        int col;
+        int n;
+    };
+
+    // Reusable stack, a cell is pushed at most once so the matrix size bounds its depth
+    static CellFrame frames[rowNumber * colNumber];
+
     // Cell has now been visited
     visitedMatrix[cellRow][cellCol] = true;
+    int top = 0;
+    frames[0].row = cellRow;
+    frames[0].col = cellCol;
+    frames[0].n = 0;
+
+    // Apply DFS iteratively for all eight neighbors
+    while (top >= 0) {
+        CellFrame& frame = frames[top];
+        if (frame.n == 8) {
+            top--;
+            continue;
+        }
+
+        int row = frame.row + neighborRow[frame.n];
+        int col = frame.col + neighborCol[frame.n];
+        frame.n++;
 
-    // Apply DFS recursively for all eight neighbors
-    for (int n = 0; n < 8; ++n) {
         // Checks if DFS needs to applied to the neighboring cell
-        if (includeDFS(matrix, visitedMatrix, cellRow + neighborRow[n], cellCol + neighborCol[n]))
-            // Apply DFS recursively
-            DFS(matrix, visitedMatrix, cellRow + neighborRow[n], cellCol + neighborCol[n]);
+        if (includeDFS(matrix, visitedMatrix, row, col)) {
+            visitedMatrix[row][col] = true;
+            frames[++top].row = row;
+            frames[top].col = col;
+            frames[top].n = 0;
+        }
+    }
+}
+
+// Class for a binary 2D matrix packed as 64 cells per word
+class BitGrid
+{
+    // Number of rows and columns
+    int rows, cols;
+
+    // Words per row
+    int wordsPerRow;
+
+    // Row-major bits, cell (r, c) is bit c % 64 of word c / 64 of row r
+    vector<uint64_t> bits;
+
+public:
+
+    // Constructor, all cells start as 0
+    BitGrid(int rows, int cols) : rows(rows), cols(cols), wordsPerRow((cols + 63) / 64), bits((size_t)rows * wordsPerRow, 0) {}
+
+    // Dimensions
+    int rowCount() const { return rows; }
+    int colCount() const { return cols; }
+
+    // Access to row r
+    const uint64_t* row(int r) const { return bits.data() + (size_t)r * wordsPerRow; }
+
+    // Cell (r, c)
+    bool get(int r, int c) const { return (row(r)[c >> 6] >> (c & 63)) & 1; }
+    void set(int r, int c) { bits[(size_t)r * wordsPerRow + (c >> 6)] |= (uint64_t)1 << (c & 63); }
+};
+
+// Connected island found by labelIslands
+struct IslandInfo
+{
+    int64_t size;            // Number of cells
+    int minRow, maxRow;      // Bounding box rows
+    int minCol, maxCol;      // Bounding box columns
+};
+
+// Horizontal run of 1 cells [begin, end) in a row
+struct CellRun
+{
+    int row, begin, end;
+};
+
+/// <summary>
+///  First column >= from whose bit equals value (or cols if there is none)
+/// </summary>
+int nextCell(const uint64_t* row, int from, int cols, bool value)
+{
+    int word = from >> 6;
+    int words = (cols + 63) >> 6;
+    if (word >= words)
+        return cols;
+
+    uint64_t bitsLeft = (value ? row[word] : ~row[word]) & (~(uint64_t)0 << (from & 63));
+    while (bitsLeft == 0) {
+        if (++word == words)
+            return cols;
+        bitsLeft = value ? row[word] : ~row[word];
+    }
+
+    return min((word << 6) + lowestBit(bitsLeft), cols);
+}
+
+/// <summary>
+///  Root of a run in the lock-free union-find (path halving with compare-and-swap)
+/// </summary>
+int findRun(vector<atomic<int> >& parent, int x)
+{
+    while (true) {
+        int p = parent[x].load(memory_order_relaxed);
+        if (p == x)
+            return x;
+        int grandParent = parent[p].load(memory_order_relaxed);
+        if (grandParent != p)
+            parent[x].compare_exchange_weak(p, grandParent, memory_order_relaxed);
+        x = grandParent;
+    }
+}
+
+/// <summary>
+///  Lock-free union: the larger root is linked under the smaller one with compare-and-swap, retrying if
+///  another thread changed it in between
+/// </summary>
+void uniteRuns(vector<atomic<int> >& parent, int a, int b)
+{
+    while (true) {
+        a = findRun(parent, a);
+        b = findRun(parent, b);
+        if (a == b)
+            return;
+        if (a < b)
+            swap(a, b);
+        int expected = a;
+        if (parent[a].compare_exchange_strong(expected, b, memory_order_acq_rel))
+            return;
+    }
+}
+
+/// <summary>
+///  Unites the 8-connected runs of two consecutive rows (runs overlap or touch diagonally)
+/// </summary>
+void uniteRows(vector<atomic<int> >& parent, const vector<CellRun>& runs, int upperBegin, int upperEnd, int lowerBegin, int lowerEnd)
+{
+    int i = upperBegin, j = lowerBegin;
+    while (i < upperEnd && j < lowerEnd) {
+        if (runs[j].begin <= runs[i].end && runs[i].begin <= runs[j].end)
+            uniteRuns(parent, i, j);
+
+        // Advance the run that finishes first
+        if (runs[i].end < runs[j].end)
+            i++;
+        else
+            j++;
+    }
+}
+
+/// <summary>
+///  Parallel connected component labelling of the 8-connected islands of a bit-packed grid
+///  The grid is split in horizontal tiles, one per thread. Each tile extracts its runs of 1s and unites
+///  the runs of consecutive rows; tile borders are then merged in parallel through a lock-free
+///  union-find. Memory grows with the number of runs, not with the number of cells
+/// </summary>
+/// <param name="grid"> Binary matrix </param>
+/// </return> Returns the islands (size and bounding box), ordered by their first cell in row-major order
+vector<IslandInfo> labelIslands(const BitGrid& grid)
+{
+    const int rows = grid.rowCount();
+    const int cols = grid.colCount();
+
+    int tileCount = (int)max(1u, thread::hardware_concurrency());
+    tileCount = max(1, min(tileCount, rows));
+    vector<int> tileBegin(tileCount + 1);
+    for (int t = 0; t <= tileCount; t++)
+        tileBegin[t] = (int)((int64_t)rows * t / tileCount);
+
+    // Runs of every tile, extracted in parallel
+    vector<vector<CellRun> > tileRuns(tileCount);
+    parallelFor(0, tileCount, [&](int first, int last) {
+        for (int t = first; t < last; t++) {
+            for (int r = tileBegin[t]; r < tileBegin[t + 1]; r++) {
+                const uint64_t* row = grid.row(r);
+                int column = nextCell(row, 0, cols, true);
+                while (column < cols) {
+                    CellRun run;
+                    run.row = r;
+                    run.begin = column;
+                    run.end = nextCell(row, column, cols, false);
+                    tileRuns[t].push_back(run);
+                    column = nextCell(row, run.end, cols, true);
+                }
+            }
+        }
+    });
+
+    // Global run array and index of the first run of every row
+    vector<int> tileOffset(tileCount + 1, 0);
+    for (int t = 0; t < tileCount; t++)
+        tileOffset[t + 1] = tileOffset[t] + (int)tileRuns[t].size();
+    const int runCount = tileOffset[tileCount];
+
+    vector<CellRun> runs(runCount);
+    vector<int> rowStart(rows + 1, 0);
+    vector<atomic<int> > parent(runCount);
+
+    parallelFor(0, tileCount, [&](int first, int last) {
+        for (int t = first; t < last; t++) {
+            copy(tileRuns[t].begin(), tileRuns[t].end(), runs.begin() + tileOffset[t]);
+            vector<CellRun>().swap(tileRuns[t]);   // Release the tile copy
+            for (int k = tileOffset[t]; k < tileOffset[t + 1]; k++)
+                parent[k].store(k, memory_order_relaxed);
+
+            // First run of every row of the tile
+            int k = tileOffset[t];
+            for (int r = tileBegin[t]; r < tileBegin[t + 1]; r++) {
+                while (k < tileOffset[t + 1] && runs[k].row < r)
+                    k++;
+                rowStart[r] = k;
+            }
+        }
+    });
+    rowStart[rows] = runCount;
+
+    // Unite consecutive rows inside every tile, then across the tile borders
+    parallelFor(0, tileCount, [&](int first, int last) {
+        for (int t = first; t < last; t++)
+            for (int r = tileBegin[t] + 1; r < tileBegin[t + 1]; r++)
+                uniteRows(parent, runs, rowStart[r - 1], rowStart[r], rowStart[r], rowStart[r + 1]);
+    });
+    parallelFor(1, tileCount, [&](int first, int last) {
+        for (int t = first; t < last; t++) {
+            int r = tileBegin[t];
+            uniteRows(parent, runs, rowStart[r - 1], rowStart[r], rowStart[r], rowStart[r + 1]);
+        }
+    });
+
+    // Resolve the root of every run in parallel
+    vector<int> root(runCount);
+    parallelFor(0, runCount, [&](int first, int last) {
+        for (int k = first; k < last; k++)
+            root[k] = findRun(parent, k);
+    });
+
+    // Island statistics, islands are numbered in the order their first run appears
+    vector<int> islandOf(runCount, -1);
+    vector<IslandInfo> islands;
+    for (int k = 0; k < runCount; k++) {
+        const CellRun& run = runs[k];
+        int& island = islandOf[root[k]];
+        if (island < 0) {
+            island = (int)islands.size();
+            IslandInfo info = { 0, run.row, run.row, run.begin, run.end - 1 };
+            islands.push_back(info);
+        }
+        IslandInfo& info = islands[island];
+        info.size += run.end - run.begin;
+        info.minRow = min(info.minRow, run.row);
+        info.maxRow = max(info.maxRow, run.row);
+        info.minCol = min(info.minCol, run.begin);
+        info.maxCol = max(info.maxCol, run.end - 1);
     }
+    return islands;
 }
 
 /// <summary>
@@ -678,48 +1864,1543 @@ void islandNumber() {
     }
     cout << "Identified number of islands: " << islandNumber << endl;
 
+    // Same matrix through the bit-packed parallel labeller
+    BitGrid grid(rowNumber, colNumber);
+    for (int i = 0; i < rowNumber; ++i)
+        for (int j = 0; j < colNumber; ++j)
+            if (matrix[i][j])
+                grid.set(i, j);
+
+    vector<IslandInfo> islands = labelIslands(grid);
+    cout << "Union-find labelling islands: " << islands.size() << endl;
+    for (size_t k = 0; k < islands.size(); k++) {
+        cout << "Island " << k << ": " << islands[k].size << " cells, rows " << islands[k].minRow << "-" << islands[k].maxRow
+             << ", columns " << islands[k].minCol << "-" << islands[k].maxCol << endl;
+    }
+
     cout << "\nPress [Enter] to continue..." << endl;
     cin.get();    // used to stop console from closing
 }
 
 #pragma endregion
 
-int main() {
+#pragma region Reachability Index
 
-	AuthorDetails();	// calls AuthorDetails method/function 
+// Class for answering "can u reach v" queries after a one-time build
+// Vertices are collapsed into the SCC condensation (a DAG) and every component gets pruned landmark
+// labels (2-hop cover): u reaches v iff the out-label of u and the in-label of v share a landmark
+class ReachabilityIndex
+{
+    // Number of vertices of the original graph
+    int V;
 
-	cout << endl;
-	cout << "------------------ DFS Examples ---------------------------" << endl;
-	cout << " Just uncomment the function in Main for the desired problem:" << endl;
-    cout << endl;
+    // Component of every vertex, ids are in reverse topological order
+    vector<int> componentOf;
 
-    cout << " - Graph DFS from a given node" << endl;
-    graphDFS(0);
-    cout << endl;
+    // Landmark ranks of the out-labels and in-labels of every component (CSR layout, sorted)
+    vector<int> outOffsets, outLabels;
+    vector<int> inOffsets, inLabels;
 
-    cout << " - Print all paths for a given source and destination" << endl;
-    printPathSourceDestination(4,3);
-    cout << endl;
+    // Returns true if the sorted labels of outComponent and inComponent intersect
+    bool labelsIntersect(int outComponent, int inComponent) const;
 
-    cout << " - Mother vertices" << endl;
-    motherVertex();
-    cout << endl;
+public:
 
-    cout << " - Identify the longest path in a graph" << endl;
-    longestPath();
-    cout << endl;
+    // Constructor, builds the index for graph g
+    ReachabilityIndex(Graph& g);
 
-    cout << " - Detect cycle in an directed graph" << endl;
-    detectCycleDirectedGraph();
-    cout << endl;
+    // Returns true if there is a directed path from u to v
+    bool reachable(int u, int v) const;
 
-    cout << " - Transitive closure for a directed graph (adjacency matrix)" << endl;
-    transitiveClosure();
+    // Answers a batch of queries, split across threads (the index is read-only after the build)
+    void reachableBatch(const vector<pair<int, int> >& queries, vector<char>& answers) const;
+
+    // Total number of landmark entries in the labels
+    size_t labelSize() const { return outLabels.size() + inLabels.size(); }
+};
+
+/// <summary>
+///  Builds the condensation DAG and its pruned landmark labels
+///  Components are processed from the highest degree down; the BFS from a landmark stops at every
+///  component whose reachability is already covered by earlier landmarks, which keeps labels small
+/// </summary>
+/// <param name="g"> Directed graph </param>
+ReachabilityIndex::ReachabilityIndex(Graph& g)
+{
+    V = g.vertexCount();
+    SCCResult scc = g.stronglyConnectedComponents();
+    componentOf = scc.componentOf;
+    const int C = scc.componentCount;
+
+    // Condensation edges, deduplicated per component
+    vector<vector<int> > forward(C), backward(C);
+    for (int v = 0; v < V; v++) {
+        for (const int* i = g.neighborsBegin(v); i != g.neighborsEnd(v); ++i) {
+            int a = componentOf[v], b = componentOf[*i];
+            if (a != b)
+                forward[a].push_back(b);
+        }
+    }
+    for (int c = 0; c < C; c++) {
+        sort(forward[c].begin(), forward[c].end());
+        forward[c].erase(unique(forward[c].begin(), forward[c].end()), forward[c].end());
+        for (size_t k = 0; k < forward[c].size(); k++)
+            backward[forward[c][k]].push_back(c);
+    }
+
+    // Landmark order: components with the largest (in + 1) * (out + 1) degree first
+    vector<int> order(C);
+    for (int c = 0; c < C; c++)
+        order[c] = c;
+    sort(order.begin(), order.end(), [&forward, &backward](int a, int b) {
+        int64_t degreeA = (int64_t)(forward[a].size() + 1) * (backward[a].size() + 1);
+        int64_t degreeB = (int64_t)(forward[b].size() + 1) * (backward[b].size() + 1);
+        return degreeA != degreeB ? degreeA > degreeB : a < b;
+    });
+
+    // Labels grow in landmark order, so every label list stays sorted
+    vector<vector<int> > outLabel(C), inLabel(C);
+    vector<char> visited(C, 0);
+    vector<int> queue;
+    queue.reserve(C);
+
+    // Intersects a (sorted) out-label with a (sorted) in-label
+    auto covered = [](const vector<int>& out, const vector<int>& in) {
+        size_t a = 0, b = 0;
+        while (a < out.size() && b < in.size()) {
+            if (out[a] == in[b])
+                return true;
+            if (out[a] < in[b])
+                a++;
+            else
+                b++;
+        }
+        return false;
+    };
+
+    for (int rank = 0; rank < C; rank++) {
+        int landmark = order[rank];
+
+        // Forward pruned BFS: the landmark enters the in-label of every component it newly covers
+        queue.clear();
+        queue.push_back(landmark);
+        visited[landmark] = 1;
+        for (size_t head = 0; head < queue.size(); head++) {
+            int c = queue[head];
+            if (covered(outLabel[landmark], inLabel[c]))
+                continue;
+            inLabel[c].push_back(rank);
+            for (size_t k = 0; k < forward[c].size(); k++) {
+                if (!visited[forward[c][k]]) {
+                    visited[forward[c][k]] = 1;
+                    queue.push_back(forward[c][k]);
+                }
+            }
+        }
+        for (size_t k = 0; k < queue.size(); k++)
+            visited[queue[k]] = 0;
+
+        // Backward pruned BFS: the landmark enters the out-label of every component that reaches it
+        queue.clear();
+        queue.push_back(landmark);
+        visited[landmark] = 1;
+        for (size_t head = 0; head < queue.size(); head++) {
+            int c = queue[head];
+            if (c != landmark && covered(outLabel[c], inLabel[landmark]))
+                continue;
+            outLabel[c].push_back(rank);
+            for (size_t k = 0; k < backward[c].size(); k++) {
+                if (!visited[backward[c][k]]) {
+                    visited[backward[c][k]] = 1;
+                    queue.push_back(backward[c][k]);
+                }
+            }
+        }
+        for (size_t k = 0; k < queue.size(); k++)
+            visited[queue[k]] = 0;
+    }
+
+    // Flatten the labels into CSR arrays
+    outOffsets.assign(C + 1, 0);
+    inOffsets.assign(C + 1, 0);
+    for (int c = 0; c < C; c++) {
+        outOffsets[c + 1] = outOffsets[c] + (int)outLabel[c].size();
+        inOffsets[c + 1] = inOffsets[c] + (int)inLabel[c].size();
+        outLabels.insert(outLabels.end(), outLabel[c].begin(), outLabel[c].end());
+        inLabels.insert(inLabels.end(), inLabel[c].begin(), inLabel[c].end());
+    }
+}
+
+bool ReachabilityIndex::labelsIntersect(int outComponent, int inComponent) const
+{
+    int a = outOffsets[outComponent], aEnd = outOffsets[outComponent + 1];
+    int b = inOffsets[inComponent], bEnd = inOffsets[inComponent + 1];
+    while (a < aEnd && b < bEnd) {
+        if (outLabels[a] == inLabels[b])
+            return true;
+        if (outLabels[a] < inLabels[b])
+            a++;
+        else
+            b++;
+    }
+    return false;
+}
+
+/// <summary>
+///  Reachability query, O(1) inside a component or against the topological order, else a label merge
+/// </summary>
+/// <param name="u"> Source vertex </param>
+/// <param name="v"> Destination vertex </param>
+bool ReachabilityIndex::reachable(int u, int v) const
+{
+    int a = componentOf[u], b = componentOf[v];
+    if (a == b)
+        return true;
+
+    // Component ids are in reverse topological order, a path can only go to a smaller id
+    if (a < b)
+        return false;
+
+    return labelsIntersect(a, b);
+}
+
+/// <summary>
+///  Answers a batch of queries with one thread per block of queries
+/// </summary>
+/// <param name="queries"> (u, v) pairs </param>
+/// <param name="answers"> 1 if u reaches v, 0 otherwise </param>
+void ReachabilityIndex::reachableBatch(const vector<pair<int, int> >& queries, vector<char>& answers) const
+{
+    answers.resize(queries.size());
+    parallelFor(0, (int)queries.size(), [this, &queries, &answers](int begin, int end) {
+        for (int q = begin; q < end; q++)
+            answers[q] = reachable(queries[q].first, queries[q].second) ? 1 : 0;
+    });
+}
+
+/// <summary>
+///  Builds a reachability index and answers every (u, v) query of a small graph
+/// </summary>
+void reachabilityQueries()
+{
+    // Display used cycle graph example
+    int edges[][2] = { {0,3},
+                       {1,0},
+                       {2,5},
+                       {3,1},
+                       {4,1},
+                       {4,2},
+                       {4,6},
+                       {6,7},
+                       {7,3} };
+
+    Graph g(colNumber);
+
+    cout << "The following directed graph example with a cycle is used:" << endl;
+    for (size_t i = 0; i < size(edges); i++) {
+        cout << edges[i][0] << " " << edges[i][1] << endl;
+        g.addDirectedEdge(edges[i][0], edges[i][1]);     //Saves edge into graph
+    }
+
+    ReachabilityIndex index(g);
+    cout << "Index label entries: " << index.labelSize() << endl;
+
+    // Submit all pairs as one batch
+    vector<pair<int, int> > queries;
+    for (int u = 0; u < colNumber; u++)
+        for (int v = 0; v < colNumber; v++)
+            queries.push_back(make_pair(u, v));
+    vector<char> answers;
+    index.reachableBatch(queries, answers);
+
+    cout << "Reachability matrix (row u reaches column v):" << endl;
+    for (int u = 0; u < colNumber; u++) {
+        for (int v = 0; v < colNumber; v++)
+            cout << (int)answers[u * colNumber + v] << " ";
+        cout << endl;
+    }
+
+    cout << "\nPress [Enter] to continue..." << endl;
+    cin.get();    // used to stop console from closing
+}
+
+#pragma endregion
+
+#pragma region Graph Snapshot
+
+/// <summary>
+///  Reads a text edge list in large blocks and parses the integers by hand (no stream per number)
+///  The vertex count is the largest vertex id plus one
+/// </summary>
+/// <param name="path"> Edge list file, one "u v" pair per line, '#' starts a comment line </param>
+/// </return> Returns false if the file cannot be read, holds an odd number of ids, a negative id or an
+/// id too large for an int vertex count
+bool Graph::importEdgeList(const string& path)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL)
+        return false;
+
+    vector<pair<int, int> > edges;
+    vector<char> buffer(1 << 20);
+    int64_t number = -1;      // Number being parsed (-1 if none)
+    int64_t pending = -1;     // First id of the current edge (-1 if none)
+    int maxId = -1;
+    bool comment = false;
+    char previous = '\n';     // Character before c, a '-' before a digit is a negative id
+    size_t bytes;
+
+    while ((bytes = fread(buffer.data(), 1, buffer.size(), file)) > 0) {
+        for (size_t k = 0; k < bytes; k++) {
+            char c = buffer[k];
+            char before = previous;
+            previous = c;
+            if (comment) {
+                comment = c != '\n';
+                continue;
+            }
+            if (c >= '0' && c <= '9') {
+                if (number < 0 && before == '-') {
+                    fclose(file);
+                    return false;
+                }
+
+                // Ids stop below INT_MAX - 1 (the CSR needs vertex count + 1 offsets), so number never overflows
+                number = (number < 0 ? 0 : number * 10) + (c - '0');
+                if (number >= INT_MAX - 1) {
+                    fclose(file);
+                    return false;
+                }
+                continue;
+            }
+            if (c == '#')
+                comment = true;
+
+            // Any other character ends the current number
+            if (number >= 0) {
+                if (pending < 0)
+                    pending = number;
+                else {
+                    edges.push_back(make_pair((int)pending, (int)number));
+                    maxId = max(maxId, (int)max(pending, number));
+                    pending = -1;
+                }
+                number = -1;
+            }
+        }
+    }
+    fclose(file);
+
+    // Last number of a file without a final newline
+    if (number >= 0) {
+        if (pending < 0)
+            return false;
+        edges.push_back(make_pair((int)pending, (int)number));
+        maxId = max(maxId, (int)max(pending, number));
+        pending = -1;
+    }
+    if (pending >= 0)
+        return false;
+
+    *this = Graph(maxId + 1);
+    pendingEdges.swap(edges);
+    freeze();
+    return true;
+}
+
+/// <summary>
+///  Writes the header, the offsets and the targets with three sequential writes
+/// </summary>
+/// <param name="path"> Snapshot file </param>
+bool Graph::saveSnapshot(const string& path)
+{
+    freeze();   // Build CSR arrays from pending edges
+
+    GraphSnapshotHeader header;
+    memcpy(header.magic, graphSnapshotMagic, sizeof(header.magic));
+    header.vertexCount = V;
+    header.edgeCount = offsetView[V];
+
+    std::ofstream oFile(path.c_str(), std::ios::binary);
+    if (!oFile)
+        return false;
+    oFile.write((const char*)&header, sizeof(header));
+    oFile.write((const char*)offsetView, (V + 1) * sizeof(int64_t));
+    oFile.write((const char*)targetView, offsetView[V] * sizeof(int));
+    oFile.close();        // Closes ouput file
+    return !oFile.fail();
+}
+
+/// <summary>
+///  Maps a snapshot and points the CSR views into it; only the header, the file size and the first and
+///  last offsets are validated, so opening costs O(1) and the pages are faulted in by the first traversal
+/// </summary>
+/// <param name="path"> Snapshot file </param>
+bool Graph::loadSnapshot(const string& path)
+{
+    shared_ptr<MappedFile> file = make_shared<MappedFile>(path);
+    if (file->data() == NULL || file->size() < sizeof(GraphSnapshotHeader))
+        return false;
+
+    GraphSnapshotHeader header;
+    memcpy(&header, file->data(), sizeof(header));
+    if (memcmp(header.magic, graphSnapshotMagic, sizeof(header.magic)) != 0 || header.vertexCount < 0 || header.vertexCount >= INT_MAX)
+        return false;
+    if (header.edgeCount < 0 || header.edgeCount > (int64_t)(file->size() / sizeof(int)))
+        return false;
+    if (file->size() != sizeof(header) + (header.vertexCount + 1) * sizeof(int64_t) + header.edgeCount * sizeof(int))
+        return false;
+
+    // The offsets must start at 0 and end at the edge count, or the targets would be read out of bounds
+    int64_t firstOffset, lastOffset;
+    memcpy(&firstOffset, file->data() + sizeof(header), sizeof(int64_t));
+    memcpy(&lastOffset, file->data() + sizeof(header) + header.vertexCount * sizeof(int64_t), sizeof(int64_t));
+    if (firstOffset != 0 || lastOffset != header.edgeCount)
+        return false;
+
+    V = (int)header.vertexCount;
+    vector<pair<int, int> >().swap(pendingEdges);
+    vector<int64_t>().swap(offsets);
+    vector<int>().swap(targets);
+    vector<DFSFrame>().swap(frames);
+    snapshot = file;
+    refreshViews();
+    return true;
+}
+
+/// <summary>
+///  Imports a text edge list, saves it as a binary snapshot and traverses the mapped snapshot
+/// </summary>
+void graphSnapshot()
+{
+    // Display used cycle graph example
+    int edges[][2] = { {0,3},
+                       {1,0},
+                       {2,5},
+                       {3,1},
+                       {4,1},
+                       {4,2},
+                       {4,6},
+                       {6,7},
+                       {7,3},
+                       {7,4} };
+
+    // Write the example as a text edge list
+    std::ofstream oFile("DFS_EdgeList.txt");
+    oFile << "# Directed graph example, one edge per line" << endl;
+    for (size_t i = 0; i < size(edges); i++)
+        oFile << edges[i][0] << " " << edges[i][1] << endl;
+    oFile.close();
+
+    Graph imported(0);
+    if (!imported.importEdgeList("DFS_EdgeList.txt") || !imported.saveSnapshot("DFS_Graph.bin")) {
+        cout << "Unable to import the edge list or to write the snapshot" << endl;
+        remove("DFS_EdgeList.txt");
+        remove("DFS_Graph.bin");
+        return;
+    }
+    cout << "Imported edge list: " << imported.vertexCount() << " vertices, " << imported.edgeCount() << " edges" << endl;
+
+    Graph mapped(0);
+    if (!mapped.loadSnapshot("DFS_Graph.bin")) {
+        cout << "Unable to open the snapshot" << endl;
+        remove("DFS_EdgeList.txt");
+        remove("DFS_Graph.bin");
+        return;
+    }
+    cout << "Mapped snapshot: " << mapped.vertexCount() << " vertices, " << mapped.edgeCount() << " edges" << endl;
+
+    cout << "DFS from node 0 on the mapped snapshot is:" << endl;
+    mapped.graphDFS(0);
     cout << endl;
 
-	cout << " - Idenify the number of islands (1's) in a binary 2D matrix" << endl;
-    islandNumber();
-	cout << endl;
+    // Release the mapping before removing the files
+    mapped = Graph(0);
+    remove("DFS_EdgeList.txt");
+    remove("DFS_Graph.bin");
+
+    cout << "\nPress [Enter] to continue..." << endl;
+    cin.get();    // used to stop console from closing
+}
+
+#pragma endregion
+
+#pragma region Parallel Traversal Engine
+
+// Result of a breadth-first traversal
+struct BFSResult
+{
+    // BFS level (distance in edges) of every vertex, -1 if unreachable
+    vector<int> level;
+
+    // BFS tree parent of every vertex, -1 for the source and unreachable vertices
+    vector<int> parent;
+};
+
+// Class for parallel traversals of a frozen graph
+// The reverse graph and the per-vertex workspace are built once and reused by every query
+class TraversalEngine
+{
+    // Graph and its reverse (for bottom-up steps)
+    Graph& g;
+    Graph reverse;
+    int V;
+
+    // Number of worker threads
+    int threadCount;
+
+    // Per-vertex claim flags shared by the threads
+    vector<atomic<int> > parentOf;
+
+    // Frontier bitmaps for bottom-up steps
+    vector<uint64_t> frontierBits, nextBits;
+
+public:
+
+    // Constructor, freezes the graph and builds its reverse
+    TraversalEngine(Graph& g);
+
+    // Direction-optimizing parallel BFS from a source
+    BFSResult breadthFirstSearch(int source);
+
+    // Work-stealing parallel DFS-order approximation, returns the reachable vertices in discovery order
+    vector<int> depthFirstOrder(int source);
+};
+
+TraversalEngine::TraversalEngine(Graph& g) : g(g), reverse(g.transpose())
+{
+    V = g.vertexCount();
+    threadCount = (int)max(1u, thread::hardware_concurrency());
+    parentOf = vector<atomic<int> >(V);
+    frontierBits.assign((V + 63) / 64, 0);
+    nextBits.assign((V + 63) / 64, 0);
+}
+
+/// <summary>
+///  Direction-optimizing BFS (top-down / bottom-up switching)
+///  Top-down steps expand the frontier queue in parallel, claiming vertices with compare-and-swap and
+///  collecting the next frontier in per-thread local queues. When the frontier's out-edges exceed
+///  1/14 of the unvisited vertices' edges, bottom-up steps let every unvisited vertex look for a parent
+///  in a frontier bitmap and stop at the first hit. It returns to top-down once the frontier shrinks
+///  below V/24 vertices
+/// </summary>
+/// <param name="source"> Source node </param>
+BFSResult TraversalEngine::breadthFirstSearch(int source)
+{
+    const int64_t alpha = 14, beta = 24;   // Switching thresholds
+    const int parallelThreshold = 1024;    // Smaller frontiers are expanded inline
+
+    BFSResult result;
+    result.level.assign(V, -1);
+    for (int v = 0; v < V; v++)
+        parentOf[v].store(-1, memory_order_relaxed);
+
+    vector<int> frontier(1, source);
+    vector<int> next;
+    mutex nextMutex;
+    parentOf[source].store(source, memory_order_relaxed);
+    result.level[source] = 0;
+
+    // Edges still to be checked by a bottom-up step
+    int64_t unexploredEdges = g.edgeCount() - (g.neighborsEnd(source) - g.neighborsBegin(source));
+    bool bottomUp = false;
+    int64_t frontierSize = 1;
+
+    for (int depth = 0; frontierSize > 0; depth++) {
+        // Out-edges of the frontier decide the direction of this step
+        int64_t frontierEdges = 0;
+        if (!bottomUp) {
+            for (size_t k = 0; k < frontier.size(); k++)
+                frontierEdges += g.neighborsEnd(frontier[k]) - g.neighborsBegin(frontier[k]);
+            if (frontierEdges > unexploredEdges / alpha) {
+                // Switch to bottom-up: queue to bitmap
+                bottomUp = true;
+                fill(frontierBits.begin(), frontierBits.end(), 0);
+                for (size_t k = 0; k < frontier.size(); k++)
+                    frontierBits[frontier[k] >> 6] |= (uint64_t)1 << (frontier[k] & 63);
+            }
+        }
+        else if (frontierSize < V / beta) {
+            // Switch back to top-down: bitmap to queue
+            bottomUp = false;
+            frontier.clear();
+            for (int v = 0; v < V; v++)
+                if ((frontierBits[v >> 6] >> (v & 63)) & 1)
+                    frontier.push_back(v);
+        }
+
+        if (!bottomUp) {
+            next.clear();
+            auto topDown = [&](int begin, int end) {
+                vector<int> localNext;
+                for (int k = begin; k < end; k++) {
+                    int u = frontier[k];
+                    for (const int* i = g.neighborsBegin(u); i != g.neighborsEnd(u); ++i) {
+                        int expected = -1;
+                        if (parentOf[*i].load(memory_order_relaxed) == -1 &&
+                            parentOf[*i].compare_exchange_strong(expected, u, memory_order_relaxed)) {
+                            result.level[*i] = depth + 1;
+                            localNext.push_back(*i);
+                        }
+                    }
+                }
+                lock_guard<mutex> lock(nextMutex);
+                next.insert(next.end(), localNext.begin(), localNext.end());
+            };
+            if ((int)frontier.size() < parallelThreshold)
+                topDown(0, (int)frontier.size());
+            else
+                parallelFor(0, (int)frontier.size(), topDown);
+
+            frontier.swap(next);
+            frontierSize = (int64_t)frontier.size();
+            for (size_t k = 0; k < frontier.size(); k++)
+                unexploredEdges -= g.neighborsEnd(frontier[k]) - g.neighborsBegin(frontier[k]);
+        }
+        else {
+            fill(nextBits.begin(), nextBits.end(), 0);
+            atomic<int64_t> found(0), foundEdges(0);
+
+            // Threads own whole bitmap words, so the next bitmap is written without atomics
+            parallelFor(0, (int)nextBits.size(), [&](int wordBegin, int wordEnd) {
+                int64_t localFound = 0, localEdges = 0;
+                for (int word = wordBegin; word < wordEnd; word++) {
+                    int last = min(V, (word + 1) * 64);
+                    for (int v = word * 64; v < last; v++) {
+                        if (parentOf[v].load(memory_order_relaxed) != -1)
+                            continue;
+                        for (const int* i = reverse.neighborsBegin(v); i != reverse.neighborsEnd(v); ++i) {
+                            if ((frontierBits[*i >> 6] >> (*i & 63)) & 1) {
+                                parentOf[v].store(*i, memory_order_relaxed);
+                                result.level[v] = depth + 1;
+                                nextBits[word] |= (uint64_t)1 << (v & 63);
+                                localFound++;
+                                localEdges += g.neighborsEnd(v) - g.neighborsBegin(v);
+                                break;
+                            }
+                        }
+                    }
+                }
+                found += localFound;
+                foundEdges += localEdges;
+            });
+
+            frontierBits.swap(nextBits);
+            frontierSize = found.load();
+            unexploredEdges -= foundEdges.load();
+        }
+    }
+
+    result.parent.resize(V);
+    for (int v = 0; v < V; v++)
+        result.parent[v] = v == source ? -1 : parentOf[v].load(memory_order_relaxed);
+    return result;
+}
+
+/// <summary>
+///  Work-stealing traversal in approximate DFS order
+///  Every thread pops the newest vertex of its own deque (depth first) and steals the oldest vertex of
+///  another deque when it runs dry, so idle threads take the largest unexplored subtrees. A vertex is
+///  claimed when it is pushed, so it is visited exactly once
+/// </summary>
+/// <param name="source"> Source node </param>
+vector<int> TraversalEngine::depthFirstOrder(int source)
+{
+    for (int v = 0; v < V; v++)
+        parentOf[v].store(-1, memory_order_relaxed);
+
+    vector<deque<int> > deques(threadCount);
+    vector<mutex> dequeMutex(threadCount);
+    vector<int> order(V);
+    atomic<int> visitedCount(0);
+    atomic<int64_t> pending(1);     // Vertices pushed but not yet processed
+
+    parentOf[source].store(source, memory_order_relaxed);
+    deques[0].push_back(source);
+
+    auto worker = [&](int self) {
+        unsigned int victim = (unsigned int)self;
+        while (pending.load(memory_order_acquire) > 0) {
+            int u = -1;
+            {
+                lock_guard<mutex> lock(dequeMutex[self]);
+                if (!deques[self].empty()) {
+                    u = deques[self].back();
+                    deques[self].pop_back();
+                }
+            }
+
+            // Steal the oldest vertex from the other deques in round-robin order
+            for (int attempt = 1; u < 0 && attempt < threadCount; attempt++) {
+                victim = (victim + 1) % threadCount;
+                if (victim == (unsigned int)self)
+                    continue;
+                lock_guard<mutex> lock(dequeMutex[victim]);
+                if (!deques[victim].empty()) {
+                    u = deques[victim].front();
+                    deques[victim].pop_front();
+                }
+            }
+            if (u < 0) {
+                this_thread::yield();
+                continue;
+            }
+
+            order[visitedCount.fetch_add(1, memory_order_relaxed)] = u;
+
+            // Neighbors are pushed in reverse so the first neighbor is explored first
+            int pushed = 0;
+            {
+                lock_guard<mutex> lock(dequeMutex[self]);
+                for (const int* i = g.neighborsEnd(u); i != g.neighborsBegin(u); ) {
+                    --i;
+                    int expected = -1;
+                    if (parentOf[*i].load(memory_order_relaxed) == -1 &&
+                        parentOf[*i].compare_exchange_strong(expected, u, memory_order_relaxed)) {
+                        deques[self].push_back(*i);
+                        pushed++;
+                    }
+                }
+            }
+            pending.fetch_add(pushed - 1, memory_order_acq_rel);
+        }
+    };
+
+    vector<thread> threads;
+    for (int t = 1; t < threadCount; t++)
+        threads.push_back(thread(worker, t));
+    worker(0);
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+
+    order.resize(visitedCount.load());
+    return order;
+}
+
+/// <summary>
+///  Runs the parallel BFS and the work-stealing DFS order on a small graph
+/// </summary>
+/// <param name="source"> Source node </param>
+void parallelTraversal(int source)
+{
+    // Display used cycle graph example
+    int edges[][2] = { {0,3},
+                       {1,0},
+                       {2,5},
+                       {3,1},
+                       {4,1},
+                       {4,2},
+                       {4,6},
+                       {6,7},
+                       {7,3},
+                       {7,4} };
+
+    Graph g(colNumber);
+
+    cout << "The following directed graph example with a cycle is used:" << endl;
+    for (size_t i = 0; i < size(edges); i++) {
+        cout << edges[i][0] << " " << edges[i][1] << endl;
+        g.addDirectedEdge(edges[i][0], edges[i][1]);     //Saves edge into graph
+    }
+
+    TraversalEngine engine(g);
+    BFSResult bfs = engine.breadthFirstSearch(source);
+
+    cout << "BFS levels and parents from node " << source << " (-1: unreachable or source):" << endl;
+    for (int v = 0; v < colNumber; v++)
+        cout << "Node " << v << ": level " << bfs.level[v] << ", parent " << bfs.parent[v] << endl;
+
+    vector<int> order = engine.depthFirstOrder(source);
+    cout << "Work-stealing DFS order from node " << source << ":" << endl;
+    for (size_t k = 0; k < order.size(); k++)
+        cout << order[k] << " ";
+    cout << endl;
+
+    cout << "\nPress [Enter] to continue..." << endl;
+    cin.get();    // used to stop console from closing
+}
+
+#pragma endregion
+
+#pragma region Incremental Cycle Detection
+
+// Class for a directed graph that grows one edge at a time and never contains a cycle
+// A topological order is kept at all times (Pearce-Kelly): an edge that agrees with the order is
+// accepted in O(1), otherwise only the vertices between its endpoints in the order are searched
+class IncrementalDAG
+{
+    // Number of vertices and edges
+    int V;
+    int E;
+
+    // Dynamic adjacency, successors and predecessors of every vertex
+    vector<vector<int> > out, in;
+
+    // Position of every vertex in the topological order, and vertex at every position
+    vector<int> ord, order;
+
+    // Search workspace, visited marks are cleared after every insertion
+    vector<char> visited;
+    vector<int> deltaF, deltaB, stack;
+
+    // Collects the successors of y placed up to upperBound, returns false if x is among them
+    bool forwardSearch(int y, int x, int upperBound);
+
+    // Collects the predecessors of x placed from lowerBound on
+    void backwardSearch(int x, int lowerBound);
+
+    // Moves the backward set before the forward set, reusing their positions
+    void reorder();
+
+public:
+
+    // Constructor, V isolated vertices in order 0..V-1
+    IncrementalDAG(int V);
+
+    // Adds a new isolated vertex at the end of the order, returns its index
+    int addVertex();
+
+    // Adds the edge u -> v, returns false (and leaves the graph unchanged) if it would close a cycle
+    bool addEdge(int u, int v);
+
+    int vertexCount() const { return V; }
+    int edgeCount() const { return E; }
+
+    // Returns true if u comes before v in the current topological order
+    bool precedes(int u, int v) const { return ord[u] < ord[v]; }
+
+    // Current topological order
+    const vector<int>& topologicalOrder() const { return order; }
+};
+
+IncrementalDAG::IncrementalDAG(int V) : V(V), E(0), out(V), in(V), ord(V), order(V), visited(V, 0)
+{
+    for (int v = 0; v < V; v++)
+        ord[v] = order[v] = v;
+}
+
+int IncrementalDAG::addVertex()
+{
+    out.push_back(vector<int>());
+    in.push_back(vector<int>());
+    ord.push_back(V);
+    order.push_back(V);
+    visited.push_back(0);
+    return V++;
+}
+
+/// <summary>
+///  Inserts an edge, keeping the topological order valid
+///  If ord[u] > ord[v], a forward search from v and a backward search from u are bounded to the
+///  affected region [ord[v], ord[u]]. Reaching u from v means the edge closes a cycle
+/// </summary>
+/// <param name="u"> Source vertex </param>
+/// <param name="v"> Destination vertex </param>
+bool IncrementalDAG::addEdge(int u, int v)
+{
+    if (u == v)
+        return false;
+
+    int lowerBound = ord[v], upperBound = ord[u];
+    if (lowerBound < upperBound) {
+        deltaF.clear();
+        deltaB.clear();
+        bool acyclic = forwardSearch(v, u, upperBound);
+        if (acyclic) {
+            backwardSearch(u, lowerBound);
+            reorder();
+        }
+        for (size_t k = 0; k < deltaF.size(); k++)
+            visited[deltaF[k]] = 0;
+        for (size_t k = 0; k < deltaB.size(); k++)
+            visited[deltaB[k]] = 0;
+        if (!acyclic)
+            return false;
+    }
+
+    out[u].push_back(v);
+    in[v].push_back(u);
+    E++;
+    return true;
+}
+
+bool IncrementalDAG::forwardSearch(int y, int x, int upperBound)
+{
+    stack.clear();
+    stack.push_back(y);
+    visited[y] = 1;
+    deltaF.push_back(y);
+    while (!stack.empty()) {
+        int w = stack.back();
+        stack.pop_back();
+        for (size_t k = 0; k < out[w].size(); k++) {
+            int z = out[w][k];
+            if (z == x)
+                return false;
+            if (!visited[z] && ord[z] < upperBound) {
+                visited[z] = 1;
+                deltaF.push_back(z);
+                stack.push_back(z);
+            }
+        }
+    }
+    return true;
+}
+
+void IncrementalDAG::backwardSearch(int x, int lowerBound)
+{
+    stack.clear();
+    stack.push_back(x);
+    visited[x] = 1;
+    deltaB.push_back(x);
+    while (!stack.empty()) {
+        int w = stack.back();
+        stack.pop_back();
+        for (size_t k = 0; k < in[w].size(); k++) {
+            int z = in[w][k];
+            if (!visited[z] && ord[z] > lowerBound) {
+                visited[z] = 1;
+                deltaB.push_back(z);
+                stack.push_back(z);
+            }
+        }
+    }
+}
+
+void IncrementalDAG::reorder()
+{
+    auto byOrder = [this](int a, int b) { return ord[a] < ord[b]; };
+    sort(deltaF.begin(), deltaF.end(), byOrder);
+    sort(deltaB.begin(), deltaB.end(), byOrder);
+
+    // Freed positions, ascending: the backward set takes the first ones, the forward set the rest
+    vector<int> positions;
+    positions.reserve(deltaF.size() + deltaB.size());
+    for (size_t k = 0; k < deltaB.size(); k++)
+        positions.push_back(ord[deltaB[k]]);
+    for (size_t k = 0; k < deltaF.size(); k++)
+        positions.push_back(ord[deltaF[k]]);
+    inplace_merge(positions.begin(), positions.begin() + deltaB.size(), positions.end());
+
+    size_t next = 0;
+    for (size_t k = 0; k < deltaB.size(); k++, next++) {
+        ord[deltaB[k]] = positions[next];
+        order[positions[next]] = deltaB[k];
+    }
+    for (size_t k = 0; k < deltaF.size(); k++, next++) {
+        ord[deltaF[k]] = positions[next];
+        order[positions[next]] = deltaF[k];
+    }
+}
+
+/// <summary>
+///  Streams the edges of a small graph into an incremental DAG, rejecting the ones that close a cycle
+/// </summary>
+void incrementalCycleDetection()
+{
+    // Display used cycle graph example
+    int edges[][2] = { {0,3},
+                       {1,0},
+                       {2,5},
+                       {3,1},
+                       {4,1},
+                       {4,2},
+                       {4,6},
+                       {6,7},
+                       {7,3},
+                       {7,4} };
+
+    IncrementalDAG dag(colNumber);
+
+    cout << "The edges of the following directed graph are added one by one:" << endl;
+    for (size_t i = 0; i < size(edges); i++) {
+        bool accepted = dag.addEdge(edges[i][0], edges[i][1]);
+        cout << edges[i][0] << " " << edges[i][1] << (accepted ? "  accepted" : "  rejected, closes a cycle") << endl;
+    }
+
+    cout << "Topological order kept by the graph:" << endl;
+    const vector<int>& order = dag.topologicalOrder();
+    for (size_t k = 0; k < order.size(); k++)
+        cout << order[k] << " ";
+    cout << endl;
+
+    cout << "\nPress [Enter] to continue..." << endl;
+    cin.get();    // used to stop console from closing
+}
+
+#pragma endregion
+
+#pragma region Multi-Source Reachability
+
+// Class for reachability of many sources at once, one bit per source
+// Masks of 256 sources (four 64-bit words, one AVX2 vector) are pushed along the SCC condensation in
+// topological order, so one pass over the edges answers the queries of 256 sources
+class MultiSourceReachability
+{
+    // Sources per pass and 64-bit words per mask
+    static constexpr int batchSources = 256;
+    static constexpr int batchWords = batchSources / 64;
+
+    // Component of every vertex, ids are in reverse topological order
+    vector<int> componentOf;
+    int componentCount;
+
+    // Condensation edges (CSR layout, deduplicated)
+    vector<int> offsets, successors;
+
+    // Computes the mask of every component for sources[first..first + count)
+    void propagate(const vector<int>& sources, int first, int count, vector<uint64_t>& masks) const;
+
+public:
+
+    // Constructor, builds the condensation of graph g
+    MultiSourceReachability(Graph& g);
+
+    // Number of targets reached by each source
+    vector<int> coverage(const vector<int>& sources, const vector<int>& targets) const;
+
+    // Sources that reach every target
+    vector<int> reachingAll(const vector<int>& sources, const vector<int>& targets) const;
+};
+
+MultiSourceReachability::MultiSourceReachability(Graph& g)
+{
+    SCCResult scc = g.stronglyConnectedComponents();
+    componentOf = scc.componentOf;
+    componentCount = scc.componentCount;
+
+    vector<vector<int> > forward(componentCount);
+    for (int v = 0; v < g.vertexCount(); v++) {
+        for (const int* i = g.neighborsBegin(v); i != g.neighborsEnd(v); ++i) {
+            int a = componentOf[v], b = componentOf[*i];
+            if (a != b)
+                forward[a].push_back(b);
+        }
+    }
+
+    offsets.assign(componentCount + 1, 0);
+    for (int c = 0; c < componentCount; c++) {
+        sort(forward[c].begin(), forward[c].end());
+        forward[c].erase(unique(forward[c].begin(), forward[c].end()), forward[c].end());
+        offsets[c + 1] = offsets[c] + (int)forward[c].size();
+        successors.insert(successors.end(), forward[c].begin(), forward[c].end());
+    }
+}
+
+/// <summary>
+///  Bit-parallel propagation: a component's mask is final once all its predecessors are done, which
+///  holds when components are visited from the highest id (sources of the DAG) down
+/// </summary>
+/// <param name="sources"> Source vertices </param>
+/// <param name="first"> First source of this pass </param>
+/// <param name="count"> Number of sources of this pass (at most 256) </param>
+/// <param name="masks"> Mask of every component, batchWords words each </param>
+void MultiSourceReachability::propagate(const vector<int>& sources, int first, int count, vector<uint64_t>& masks) const
+{
+    masks.assign((size_t)componentCount * batchWords, 0);
+    for (int s = 0; s < count; s++)
+        masks[(size_t)componentOf[sources[first + s]] * batchWords + (s >> 6)] |= (uint64_t)1 << (s & 63);
+
+    for (int c = componentCount - 1; c >= 0; c--) {
+        const uint64_t* mask = masks.data() + (size_t)c * batchWords;
+        if ((mask[0] | mask[1] | mask[2] | mask[3]) == 0)
+            continue;
+        for (int k = offsets[c]; k < offsets[c + 1]; k++)
+            orRow(masks.data() + (size_t)successors[k] * batchWords, mask, batchWords);
+    }
+}
+
+/// <summary>
+///  Counts the targets reached by each source, one propagation per 256 sources (passes run in parallel)
+/// </summary>
+/// <param name="sources"> Source vertices </param>
+/// <param name="targets"> Target vertices </param>
+vector<int> MultiSourceReachability::coverage(const vector<int>& sources, const vector<int>& targets) const
+{
+    vector<int> count(sources.size(), 0);
+    int passes = ((int)sources.size() + batchSources - 1) / batchSources;
+
+    parallelFor(0, passes, [&](int begin, int end) {
+        vector<uint64_t> masks;
+        for (int pass = begin; pass < end; pass++) {
+            int first = pass * batchSources;
+            propagate(sources, first, min(batchSources, (int)sources.size() - first), masks);
+            for (size_t t = 0; t < targets.size(); t++) {
+                const uint64_t* mask = masks.data() + (size_t)componentOf[targets[t]] * batchWords;
+                for (int w = 0; w < batchWords; w++)
+                    for (uint64_t bits = mask[w]; bits; bits &= bits - 1)
+                        count[first + w * 64 + lowestBit(bits)]++;
+            }
+        }
+    });
+    return count;
+}
+
+/// <summary>
+///  Finds the sources that reach every target by AND-ing the target masks (batched mother vertex test)
+/// </summary>
+/// <param name="sources"> Candidate vertices </param>
+/// <param name="targets"> Vertices that must be reached </param>
+vector<int> MultiSourceReachability::reachingAll(const vector<int>& sources, const vector<int>& targets) const
+{
+    int passes = ((int)sources.size() + batchSources - 1) / batchSources;
+    vector<char> reachesAll(sources.size(), 0);
+
+    parallelFor(0, passes, [&](int begin, int end) {
+        vector<uint64_t> masks;
+        for (int pass = begin; pass < end; pass++) {
+            int first = pass * batchSources;
+            int count = min(batchSources, (int)sources.size() - first);
+            propagate(sources, first, count, masks);
+
+            uint64_t all[batchWords];
+            for (int w = 0; w < batchWords; w++)
+                all[w] = ~(uint64_t)0;
+            for (size_t t = 0; t < targets.size(); t++) {
+                const uint64_t* mask = masks.data() + (size_t)componentOf[targets[t]] * batchWords;
+                for (int w = 0; w < batchWords; w++)
+                    all[w] &= mask[w];
+            }
+            for (int s = 0; s < count; s++)
+                reachesAll[first + s] = (all[s >> 6] >> (s & 63)) & 1;
+        }
+    });
+
+    vector<int> result;
+    for (size_t s = 0; s < sources.size(); s++)
+        if (reachesAll[s])
+            result.push_back(sources[s]);
+    return result;
+}
+
+/// <summary>
+///  Tests every vertex of a small graph as a candidate at once: coverage and mother vertices
+/// </summary>
+void multiSourceReachability()
+{
+    // Display used cycle graph example
+    int edges[][2] = { {0,3},
+                       {1,0},
+                       {2,5},
+                       {3,1},
+                       {4,1},
+                       {4,2},
+                       {4,6},
+                       {6,7},
+                       {7,4} };
+
+    Graph g(colNumber);
+
+    cout << "The following directed graph example with a cycle is used:" << endl;
+    for (size_t i = 0; i < size(edges); i++) {
+        cout << edges[i][0] << " " << edges[i][1] << endl;
+        g.addDirectedEdge(edges[i][0], edges[i][1]);     //Saves edge into graph
+    }
+
+    vector<int> all(colNumber);
+    for (int v = 0; v < colNumber; v++)
+        all[v] = v;
+
+    MultiSourceReachability reach(g);
+    vector<int> count = reach.coverage(all, all);
+    cout << "Vertices covered by each candidate:" << endl;
+    for (int v = 0; v < colNumber; v++)
+        cout << "Node " << v << ": " << count[v] << endl;
+
+    vector<int> mother = reach.reachingAll(all, all);
+    cout << "Number of mother vertices: " << mother.size() << endl;
+    for (size_t i = 0; i < mother.size(); i++)
+        cout << mother[i] << " ";
+    cout << endl;
+
+    cout << "\nPress [Enter] to continue..." << endl;
+    cin.get();    // used to stop console from closing
+}
+
+#pragma endregion
+
+#pragma region Compressed Graph
+
+// Stream-VByte lookup tables: data bytes and pshufb mask of every control byte
+// A control byte holds the byte lengths (2 bits, 1 to 4 bytes) of four consecutive values
+struct StreamVByteTables
+{
+    uint8_t length[256];
+    uint8_t shuffle[256][16];
+
+    StreamVByteTables()
+    {
+        for (int control = 0; control < 256; control++) {
+            int position = 0;
+            for (int lane = 0; lane < 4; lane++) {
+                int bytes = ((control >> (2 * lane)) & 3) + 1;
+                for (int b = 0; b < 4; b++)
+                    shuffle[control][lane * 4 + b] = b < bytes ? (uint8_t)(position + b) : 0x80;   // 0x80 zeroes the byte
+                position += bytes;
+            }
+            length[control] = (uint8_t)position;
+        }
+    }
+};
+
+// Built once on first use
+inline const StreamVByteTables& streamVByteTables()
+{
+    static const StreamVByteTables tables;
+    return tables;
+}
+
+/// <summary>
+///  Decodes one group of four delta-coded values with a running prefix sum
+///  With SSSE3 the four values are gathered by one byte shuffle and summed in two shift-adds
+/// </summary>
+/// <param name="control"> Control byte of the group </param>
+/// <param name="data"> Data bytes of the group (at least 16 readable bytes) </param>
+/// <param name="previous"> Last decoded value, updated </param>
+/// <param name="out"> Four decoded values </param>
+/// </return> Returns the number of data bytes consumed
+inline int decodeGroup(uint8_t control, const uint8_t* data, int& previous, int* out)
+{
+    const StreamVByteTables& tables = streamVByteTables();
+#if defined(__SSSE3__) || defined(__AVX2__)
+    __m128i bytes = _mm_loadu_si128((const __m128i*)data);
+    __m128i values = _mm_shuffle_epi8(bytes, _mm_loadu_si128((const __m128i*)tables.shuffle[control]));
+    values = _mm_add_epi32(values, _mm_slli_si128(values, 4));
+    values = _mm_add_epi32(values, _mm_slli_si128(values, 8));
+    values = _mm_add_epi32(values, _mm_set1_epi32(previous));
+    _mm_storeu_si128((__m128i*)out, values);
+    previous = out[3];
+#else
+    int position = 0;
+    for (int lane = 0; lane < 4; lane++) {
+        int bytes = ((control >> (2 * lane)) & 3) + 1;
+        uint32_t value = 0;
+        for (int b = 0; b < bytes; b++)
+            value |= (uint32_t)data[position + b] << (8 * b);
+        position += bytes;
+        previous += (int)value;
+        out[lane] = previous;
+    }
+#endif
+    return tables.length[control];
+}
+
+// Sequential reader of one compressed neighbor list, used to resume a DFS frame
+struct NeighborCursor
+{
+    const uint8_t* control;     // Next control byte
+    const uint8_t* data;        // Next data byte
+    int remaining;              // Values not yet decoded
+    int previous;               // Last decoded neighbor (delta base)
+    int buffer[4];              // Current group
+    int position, count;        // Read position and size of the current group
+
+    // Reads the next neighbor into w, returns false at the end of the list
+    bool next(int& w)
+    {
+        if (position == count) {
+            if (remaining == 0)
+                return false;
+            count = min(4, remaining);
+            decodeGroup(*control, data, previous, buffer);
+            data += streamVByteTables().length[*control] - (4 - count);   // Unused lanes of the last group take one byte each
+            control++;
+            remaining -= count;
+            position = 0;
+        }
+        w = buffer[position++];
+        return true;
+    }
+};
+
+// Class for a read-only directed graph with compressed adjacency
+// Every neighbor list is sorted, deduplicated and delta coded with Stream-VByte: one control byte per
+// four neighbors followed by their 1 to 4 byte gaps. Small gaps (local or renumbered graphs) take one
+// byte per edge instead of four in the CSR arrays
+class CompressedGraph
+{
+    // Number of vertices and edges
+    int V;
+    int64_t E;
+
+    // Start of every vertex list in the byte stream, and degree of every vertex
+    vector<int64_t> offsets;
+    vector<int> degrees;
+
+    // Control bytes then data bytes of every vertex, padded with 16 bytes for unaligned SIMD loads
+    vector<uint8_t> bytes;
+
+    // Largest degree, sizes the decode buffers
+    int maxDegree;
+
+public:
+
+    // Constructor, compresses a graph (which may be a memory-mapped snapshot)
+    CompressedGraph(Graph& g);
+
+    int vertexCount() const { return V; }
+    int64_t edgeCount() const { return E; }
+    int degree(int v) const { return degrees[v]; }
+
+    // Bytes used by the adjacency (offsets, degrees and encoded lists)
+    size_t memoryBytes() const { return offsets.size() * sizeof(int64_t) + degrees.size() * sizeof(int) + bytes.size(); }
+
+    // Decodes the sorted neighbors of v into out (room for degree(v) + 3 values), returns the degree
+    int neighbors(int v, int* out) const;
+
+    // Cursor over the neighbors of v
+    NeighborCursor cursor(int v) const;
+
+    // BFS level of every vertex from source (-1 if unreachable)
+    vector<int> bfsLevels(int source) const;
+
+    // Vertices reachable from source in DFS preorder (neighbors in increasing order)
+    vector<int> dfsOrder(int source) const;
+};
+
+/// <summary>
+///  Two passes in parallel: encoded size of every list, then encoding into the prefix-summed offsets
+/// </summary>
+/// <param name="g"> Directed graph </param>
+CompressedGraph::CompressedGraph(Graph& g)
+{
+    g.freeze();
+    V = g.vertexCount();
+    offsets.assign(V + 1, 0);
+    degrees.assign(V, 0);
+
+    // Sorted unique neighbors of v
+    auto sortedNeighbors = [&g](int v, vector<int>& list) {
+        list.assign(g.neighborsBegin(v), g.neighborsEnd(v));
+        sort(list.begin(), list.end());
+        list.erase(unique(list.begin(), list.end()), list.end());
+    };
+
+    // Bytes of a gap
+    auto gapBytes = [](uint32_t gap) { return gap < (1u << 8) ? 1 : gap < (1u << 16) ? 2 : gap < (1u << 24) ? 3 : 4; };
+
+    parallelFor(0, V, [&](int begin, int end) {
+        vector<int> list;
+        for (int v = begin; v < end; v++) {
+            sortedNeighbors(v, list);
+            int64_t size = (list.size() + 3) / 4;
+            for (size_t k = 0; k < list.size(); k++)
+                size += gapBytes((uint32_t)(list[k] - (k ? list[k - 1] : 0)));
+            degrees[v] = (int)list.size();
+            offsets[v + 1] = size;
+        }
+    });
+    for (int v = 0; v < V; v++)
+        offsets[v + 1] += offsets[v];
+    bytes.assign(offsets[V] + 16, 0);
+
+    parallelFor(0, V, [&](int begin, int end) {
+        vector<int> list;
+        for (int v = begin; v < end; v++) {
+            sortedNeighbors(v, list);
+            uint8_t* control = bytes.data() + offsets[v];
+            uint8_t* data = control + (list.size() + 3) / 4;
+            for (size_t k = 0; k < list.size(); k++) {
+                uint32_t gap = (uint32_t)(list[k] - (k ? list[k - 1] : 0));
+                int length = gapBytes(gap);
+                control[k / 4] |= (uint8_t)((length - 1) << (2 * (k % 4)));
+                for (int b = 0; b < length; b++)
+                    *data++ = (uint8_t)(gap >> (8 * b));
+            }
+        }
+    });
+
+    E = 0;
+    maxDegree = 0;
+    for (int v = 0; v < V; v++) {
+        E += degrees[v];
+        maxDegree = max(maxDegree, degrees[v]);
+    }
+}
+
+int CompressedGraph::neighbors(int v, int* out) const
+{
+    const uint8_t* control = bytes.data() + offsets[v];
+    const uint8_t* data = control + (degrees[v] + 3) / 4;
+    int previous = 0;
+
+    // Full groups; the last partial group also decodes four lanes, hence the 3 spare slots of out
+    for (int k = 0; k < degrees[v]; k += 4)
+        data += decodeGroup(*control++, data, previous, out + k);
+    return degrees[v];
+}
+
+NeighborCursor CompressedGraph::cursor(int v) const
+{
+    NeighborCursor c;
+    c.control = bytes.data() + offsets[v];
+    c.data = c.control + (degrees[v] + 3) / 4;
+    c.remaining = degrees[v];
+    c.previous = 0;
+    c.position = c.count = 0;
+    return c;
+}
+
+/// <summary>
+///  Queue-based BFS, every list is decoded in bulk into one reused buffer
+/// </summary>
+/// <param name="source"> Source node </param>
+vector<int> CompressedGraph::bfsLevels(int source) const
+{
+    vector<int> level(V, -1);
+    vector<int> queue;
+    vector<int> buffer(maxDegree + 4);
+    queue.reserve(V);
+
+    level[source] = 0;
+    queue.push_back(source);
+    for (size_t head = 0; head < queue.size(); head++) {
+        int u = queue[head];
+        int count = neighbors(u, buffer.data());
+        for (int k = 0; k < count; k++) {
+            if (level[buffer[k]] < 0) {
+                level[buffer[k]] = level[u] + 1;
+                queue.push_back(buffer[k]);
+            }
+        }
+    }
+    return level;
+}
+
+/// <summary>
+///  Iterative DFS, every stack frame keeps a cursor so lists are decoded only as far as they are explored
+/// </summary>
+/// <param name="source"> Source node </param>
+vector<int> CompressedGraph::dfsOrder(int source) const
+{
+    vector<char> visited(V, 0);
+    vector<int> order;
+    vector<NeighborCursor> frames;
+
+    visited[source] = 1;
+    order.push_back(source);
+    frames.push_back(cursor(source));
+    while (!frames.empty()) {
+        int w;
+        if (!frames.back().next(w)) {
+            frames.pop_back();
+        }
+        else if (!visited[w]) {
+            visited[w] = 1;
+            order.push_back(w);
+            frames.push_back(cursor(w));
+        }
+    }
+    return order;
+}
+
+/// <summary>
+///  Compresses a small graph and traverses it without decompressing it
+/// </summary>
+/// <param name="source"> Source node </param>
+void compressedGraph(int source)
+{
+    // Display used cycle graph example
+    int edges[][2] = { {0,3},
+                       {1,0},
+                       {2,5},
+                       {3,1},
+                       {4,1},
+                       {4,2},
+                       {4,6},
+                       {6,7},
+                       {7,3},
+                       {7,4} };
+
+    Graph g(colNumber);
+
+    cout << "The following directed graph example with a cycle is used:" << endl;
+    for (size_t i = 0; i < size(edges); i++) {
+        cout << edges[i][0] << " " << edges[i][1] << endl;
+        g.addDirectedEdge(edges[i][0], edges[i][1]);     //Saves edge into graph
+    }
+
+    CompressedGraph compressed(g);
+    cout << "Compressed adjacency: " << compressed.memoryBytes() << " bytes for " << compressed.edgeCount() << " edges" << endl;
+
+    vector<int> level = compressed.bfsLevels(source);
+    cout << "BFS levels from node " << source << " (-1: unreachable):" << endl;
+    for (int v = 0; v < colNumber; v++)
+        cout << level[v] << " ";
+    cout << endl;
+
+    vector<int> order = compressed.dfsOrder(source);
+    cout << "DFS order from node " << source << ":" << endl;
+    for (size_t k = 0; k < order.size(); k++)
+        cout << order[k] << " ";
+    cout << endl;
+
+    cout << "\nPress [Enter] to continue..." << endl;
+    cin.get();    // used to stop console from closing
+}
+
+#pragma endregion
+
+int main() {
+
+	AuthorDetails();	// calls AuthorDetails method/function 
+
+	cout << endl;
+	cout << "------------------ DFS Examples ---------------------------" << endl;
+	cout << " Just uncomment the function in Main for the desired problem:" << endl;
+    cout << endl;
+
+    cout << " - Graph DFS from a given node" << endl;
+    graphDFS(0);
+    cout << endl;
+
+    cout << " - Print all paths for a given source and destination" << endl;
+    printPathSourceDestination(4,3);
+    cout << endl;
+
+    cout << " - Mother vertices" << endl;
+    motherVertex();
+    cout << endl;
+
+    cout << " - Identify the longest path in a graph" << endl;
+    longestPath();
+    cout << endl;
+
+    cout << " - Detect cycle in an directed graph" << endl;
+    detectCycleDirectedGraph();
+    cout << endl;
+
+    cout << " - Transitive closure for a directed graph (adjacency matrix)" << endl;
+    transitiveClosure();
+    cout << endl;
+
+	cout << " - Idenify the number of islands (1's) in a binary 2D matrix" << endl;
+    islandNumber();
+	cout << endl;
+
+    cout << " - Reachability index queries" << endl;
+    reachabilityQueries();
+    cout << endl;
+
+    cout << " - Edge list import and memory-mapped graph snapshot" << endl;
+    graphSnapshot();
+    cout << endl;
+
+    cout << " - Parallel direction-optimizing BFS and work-stealing DFS order" << endl;
+    parallelTraversal(4);
+    cout << endl;
+
+    cout << " - Incremental cycle detection while edges are added" << endl;
+    incrementalCycleDetection();
+    cout << endl;
+
+    cout << " - Bit-parallel multi-source reachability and coverage" << endl;
+    multiSourceReachability();
+    cout << endl;
+
+    cout << " - Compressed adjacency traversal" << endl;
+    compressedGraph(4);
+    cout << endl;
 
     return 0;
 }
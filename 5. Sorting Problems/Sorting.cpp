@@ -9,12 +9,39 @@
 // --------------------------------------------------------------------------
 
 // Libraries
+#include <atomic>		// Lock-free counters shared by threads
+#include <condition_variable>	// Sleeping pool workers
+#include <cmath>		// log(), exp(), sqrt() of the Floyd-Rivest window
+#include <cstdint>		// Fixed width integers, int64_t, ...
+#include <cstdio>		// Run files, fopen(), fread(), fwrite(), ...
 #include <cstdlib>		// General purpose function, abs(), ...
+#include <deque>		// Double-ended task queues for work stealing
+#include <functional>	// Type-erased tasks, invoke(), less<>, greater<>
+#include <future>		// Background reads and writes of run files
+#include <iterator>		// iterator_traits
 #include <ilcplex/ilocplex.h>	// CPLEX library
+#include <memory>		// unique_ptr
+#include <mutex>		// Mutual exclusion for the task queues
+#include <numeric>		// accumulate(), record counts of the external sort runs
 #include <string>		// String manipulation
 #include <list>
 #include <vector>
 #include <stack>
+#include <thread>		// Worker threads for the parallel algorithms
+#include <type_traits>	// make_unsigned
+#include <utility>		// index_sequence, unrolled sorting networks
+#ifdef __AVX2__
+#include <immintrin.h>	// AVX2 bitonic kernels
+#endif
+#ifdef _WIN32
+#include <process.h>	// _getpid(), unique run file names
+#else
+#include <unistd.h>		// getpid(), unique run file names
+#endif
+#ifdef SORTING_BENCHMARK
+#include <chrono>		// Benchmark timings
+#include <random>		// Benchmark input distributions
+#endif
 
 ILOSTLBEGIN // IBM macro to allow run the application in c++ with STL (Standard Template Library)
 
@@ -48,231 +75,2733 @@ void printArray(int unsArray[], int n)
     }cout << endl;
 }
 
+// Projection that returns its argument unchanged
+struct Identity
+{
+    template <typename T>
+    T&& operator()(T&& value) const { return forward<T>(value); }
+};
+
+// Strict weak order on projected values, comp(proj(a), proj(b))
+// Comparator and projection are stored by value, so every call inlines (no function pointers)
+template <typename Compare, typename Projection>
+struct ProjectedLess
+{
+    Compare comp;
+    Projection proj;
+
+    template <typename T, typename U>
+    bool operator()(T&& a, U&& b) const { return invoke(comp, invoke(proj, forward<T>(a)), invoke(proj, forward<U>(b))); }
+};
+
+/// <summary>
+///  Combines a comparator and a projection (a function or a data member pointer, e.g. &Leg::cost)
+/// </summary>
+/// <param name="comp"> Comparator, e.g. less<>() or greater<>() </param>
+/// <param name="proj"> Projection applied to both arguments </param>
+template <typename Compare, typename Projection>
+ProjectedLess<Compare, Projection> makeLess(Compare comp, Projection proj)
+{
+    return ProjectedLess<Compare, Projection>{ comp, proj };
+}
+
+#pragma endregion
+
+#pragma region Sorting Networks
+
+// Largest size sorted by a sorting network
+#define SMALL_SORT_MAX 32
+
+// Insertion sort (Insertion Sort region), base case when a network does not apply
+template <typename RandomIt, typename Less>
+void insertionSortRange(RandomIt unsArray, int n, Less lessThan);
+
+// Introsort (Quick Sort region), for arithmetic values above SMALL_SORT_MAX
+template <typename RandomIt, typename Less>
+void introSortRange(RandomIt unsArray, int n, Less lessThan);
+
+// Comparators of a sorting network, positions (first[c], second[c]) applied in order
+struct SortingNetwork
+{
+    int size;
+    unsigned char first[256];
+    unsigned char second[256];
+};
+
+/// <summary>
+///  Batcher's odd-even merge sort network for n inputs, generated at compile time
+///  The network of the next power of two is built and comparators touching positions n and above are
+///  dropped, which is the same as padding with +infinity (191 comparators for n = 32)
+/// </summary>
+/// <param name="n"> Number of inputs (at most SMALL_SORT_MAX) </param>
+constexpr SortingNetwork makeSortingNetwork(int n)
+{
+    SortingNetwork network = { 0, {}, {} };
+    int p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+
+    for (int t = 1; t < p; t <<= 1) {
+        for (int k = t; k >= 1; k >>= 1) {
+            for (int j = k % t; j + k < p; j += 2 * k) {
+                for (int i = 0; i < k && i + j + k < p; i++) {
+                    if ((i + j) / (2 * t) == (i + j + k) / (2 * t) && i + j + k < n) {
+                        network.first[network.size] = (unsigned char)(i + j);
+                        network.second[network.size] = (unsigned char)(i + j + k);
+                        network.size++;
+                    }
+                }
+            }
+        }
+    }
+    return network;
+}
+
+// Network of every size, evaluated by the compiler
+template <int n>
+constexpr SortingNetwork sortingNetwork = makeSortingNetwork(n);
+
+// true if equal elements are indistinguishable (arithmetic values under less or greater), so an
+// unstable network can replace the stable insertion sort
+template <typename Value, typename Less>
+struct NetworkSortable : false_type {};
+
+template <typename Value, typename Compare>
+struct NetworkSortable<Value, ProjectedLess<Compare, Identity> > : integral_constant<bool, is_arithmetic<Value>::value &&
+    (is_same<Compare, less<> >::value || is_same<Compare, greater<> >::value ||
+     is_same<Compare, less<Value> >::value || is_same<Compare, greater<Value> >::value)> {};
+
+// true for ascending int arrays, sorted by the AVX2 kernels
+template <typename RandomIt, typename Less>
+struct AscendingIntArray : false_type {};
+
+template <>
+struct AscendingIntArray<int*, ProjectedLess<less<>, Identity> > : true_type {};
+
+template <>
+struct AscendingIntArray<int*, ProjectedLess<less<int>, Identity> > : true_type {};
+
+/// <summary>
+///  Compare-exchange of positions i < j, written as two selects so it compiles to min/max or cmov
+/// </summary>
+template <typename RandomIt, typename Less>
+inline void compareExchange(RandomIt unsArray, int i, int j, Less lessThan)
+{
+    auto a = unsArray[i];
+    auto b = unsArray[j];
+    bool swapped = lessThan(b, a);
+    unsArray[i] = swapped ? b : a;
+    unsArray[j] = swapped ? a : b;
+}
+
+/// <summary>
+///  Applies the network of size n, fully unrolled
+/// </summary>
+template <int n, typename RandomIt, typename Less, size_t... c>
+inline void applySortingNetwork([[maybe_unused]] RandomIt unsArray, [[maybe_unused]] Less lessThan, index_sequence<c...>)
+{
+    (compareExchange(unsArray, sortingNetwork<n>.first[c], sortingNetwork<n>.second[c], lessThan), ...);
+}
+
+template <int n, typename RandomIt, typename Less>
+void networkSort(RandomIt unsArray, Less lessThan)
+{
+    applySortingNetwork<n>(unsArray, lessThan, make_index_sequence<sortingNetwork<n>.size>());
+}
+
+/// <summary>
+///  Runs the network of size count, a chain of direct calls the compiler inlines (no function pointers)
+/// </summary>
+template <typename RandomIt, typename Less, size_t... n>
+void networkSortDispatch(RandomIt unsArray, int count, Less lessThan, index_sequence<n...>)
+{
+    (void)((count == (int)n && (networkSort<(int)n>(unsArray, lessThan), true)) || ...);
+}
+
+#ifdef __AVX2__
+
+// Lane i ^ j of every lane: one in-lane shuffle or one 128-bit swap, no index vector
+template <int j>
+inline __m256i bitonicPartner(__m256i v)
+{
+    if constexpr (j == 4) {
+        return _mm256_permute2x128_si256(v, v, 1);
+    }
+    else if constexpr (j == 2) {
+        return _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+    else {
+        return _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+    }
+}
+
+// Blend immediate of a layer: bit i set when lane i keeps the maximum, i.e. it is the upper lane of
+// its pair in an ascending block (bit k of its position clear) or the lower lane in a descending one
+constexpr int bitonicMaxMask(int j, int k, int base)
+{
+    int mask = 0;
+    for (int i = 0; i < 8; i++) {
+        if ((((base + i) & k) == 0) == ((i & j) != 0)) {
+            mask |= 1 << i;
+        }
+    }
+    return mask;
+}
+
+/// <summary>
+///  One layer of a bitonic network inside a register of 8 ints, every lane meets lane i ^ j
+///  Shuffle and blend mask are immediates, so a layer is 4 instructions
+/// </summary>
+/// <param name="j"> Distance of the pairs (4, 2 or 1) </param>
+/// <param name="k"> Size of the bitonic blocks </param>
+/// <param name="base"> Position of lane 0 in the whole array </param>
+template <int j, int k, int base>
+inline __m256i bitonicLayer(__m256i v)
+{
+    __m256i other = bitonicPartner<j>(v);
+    return _mm256_blend_epi32(_mm256_min_epi32(v, other), _mm256_max_epi32(v, other), bitonicMaxMask(j, k, base));
+}
+
+// Layer of distance j inside every register
+template <int j, int k, size_t... r>
+inline void bitonicLayers(__m256i* v, index_sequence<r...>)
+{
+    ((v[r] = bitonicLayer<j, k, (int)r * 8>(v[r])), ...);
+}
+
+/// <summary>
+///  Layers j, j / 2, ..., 1 of the merge of bitonic blocks of size k, unrolled at compile time
+///  Pairs 8 or more positions apart are whole-register min/max, closer pairs are lane shuffles
+/// </summary>
+template <int R, int k, int j>
+inline void bitonicMergeLayers(__m256i* v)
+{
+    if constexpr (j >= 8) {
+        for (int r = 0; r < R; r++) {
+            int partner = r ^ (j >> 3);
+            if (partner > r) {
+                bool ascending = ((r * 8) & k) == 0;
+                __m256i low = _mm256_min_epi32(v[r], v[partner]);
+                __m256i high = _mm256_max_epi32(v[r], v[partner]);
+                v[r] = ascending ? low : high;
+                v[partner] = ascending ? high : low;
+            }
+        }
+    }
+    else {
+        bitonicLayers<j, k>(v, make_index_sequence<R>());
+    }
+
+    if constexpr (j > 1) {
+        bitonicMergeLayers<R, k, j / 2>(v);
+    }
+}
+
+/// <summary>
+///  Bitonic sort of 8 * R ints held in R registers (R = 1, 2, 4 for 8, 16, 32 lanes): merges of
+///  blocks of 2, 4, ..., 8 * R
+/// </summary>
+template <int R, int k = 2>
+inline void bitonicSortRegisters(__m256i* v)
+{
+    bitonicMergeLayers<R, k, k / 2>(v);
+    if constexpr (k < 8 * R) {
+        bitonicSortRegisters<R, 2 * k>(v);
+    }
+}
+
+/// <summary>
+///  Sorts exactly 8 * R ints in registers
+///  Only full registers: padding a shorter array (masked or through a stack copy) costs more than the
+///  scalar network saves, so other sizes stay on the network
+/// </summary>
+template <int R>
+void bitonicSortInts(int* unsArray)
+{
+    __m256i v[R];
+    for (int r = 0; r < R; r++) {
+        v[r] = _mm256_loadu_si256((const __m256i*)(unsArray + 8 * r));
+    }
+    bitonicSortRegisters<R>(v);
+    for (int r = 0; r < R; r++) {
+        _mm256_storeu_si256((__m256i*)(unsArray + 8 * r), v[r]);
+    }
+}
+
+#endif
+
+/// <summary>
+///  Sorts up to SMALL_SORT_MAX elements: AVX2 bitonic kernels for 8, 16 or 32 ascending ints, unrolled
+///  networks for other arithmetic values, insertion sort for everything else (records stay stable)
+///  Larger arithmetic ranges are introsorted, larger records still insertion sorted
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void smallSortRange(RandomIt unsArray, int n, Less lessThan)
+{
+    typedef typename iterator_traits<RandomIt>::value_type Value;
+    if (n < 2) {
+        return;
+    }
+
+#ifdef __AVX2__
+    if constexpr (AscendingIntArray<RandomIt, Less>::value) {
+        if (n == 8 || n == 16 || n == 32) {
+            if (n == 8) {
+                bitonicSortInts<1>(unsArray);
+            }
+            else if (n == 16) {
+                bitonicSortInts<2>(unsArray);
+            }
+            else {
+                bitonicSortInts<4>(unsArray);
+            }
+            return;
+        }
+    }
+#endif
+
+    if constexpr (NetworkSortable<Value, Less>::value) {
+        if (n > SMALL_SORT_MAX) {
+            introSortRange(unsArray, n, lessThan);
+        }
+        else {
+            networkSortDispatch(unsArray, n, lessThan, make_index_sequence<SMALL_SORT_MAX + 1>());
+        }
+    }
+    else {
+        insertionSortRange(unsArray, n, lessThan);
+    }
+}
+
+/// <summary>
+///  Small sort algorithm (sorting network or AVX2 bitonic kernel)
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array (introsort above SMALL_SORT_MAX) </param>
+void smallSortAlgorithm(int unsArray[], int n)
+{
+    smallSortRange(unsArray, n, makeLess(less<>(), Identity()));
+}
+
+#pragma endregion
+
+#pragma region Heap Sort Algorithm
+
+/// <summary>
+///  Moves unsArray[root] down a max-heap of size n until both children are smaller
+/// </summary>
+/// <param name="unsArray"> Heap array </param>
+/// <param name="root"> Index of the number to move down </param>
+/// <param name="n"> Size of heap </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void siftDown(RandomIt unsArray, int root, int n, Less lessThan)
+{
+    auto number = move(unsArray[root]);
+
+    // Loop while root has a child
+    while (2 * root + 1 < n)
+    {
+        // Pick the larger child
+        int child = 2 * root + 1;
+        if (child + 1 < n && lessThan(unsArray[child], unsArray[child + 1])) {
+            child++;
+        }
+
+        if (!lessThan(number, unsArray[child])) {
+            break;
+        }
+        unsArray[root] = move(unsArray[child]);
+        root = child;
+    }
+    unsArray[root] = move(number);
+}
+
+/// <summary>
+///  Heap sort of n elements, O(n log n) in every case
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void heapSortRange(RandomIt unsArray, int n, Less lessThan)
+{
+    // Build max-heap bottom-up
+    for (int i = n / 2 - 1; i >= 0; i--) {
+        siftDown(unsArray, i, n, lessThan);
+    }
+
+    // Move the maximum behind the heap and restore the heap
+    for (int i = n - 1; i > 0; i--)
+    {
+        swap(unsArray[0], unsArray[i]);
+        siftDown(unsArray, 0, i, lessThan);
+    }
+}
+
+/// <summary>
+///  Heap sort of [first, last) by comp(proj(a), proj(b))
+/// </summary>
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void heapSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    heapSortRange(first, (int)(last - first), makeLess(comp, proj));
+}
+
+/// <summary>
+///  Heap sort algorithm, O(n log n) in every case
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+void heapSortAlgorithm(int unsArray[], int n)
+{
+    heapSort(unsArray, unsArray + n);
+}
+
+#pragma endregion
+
+#pragma region Quick Sort Algorithm (Introsort)
+
+// Partitions up to this size are finished by insertion sort (SMALL_SORT_MAX for sorting networks)
+#define INSERTION_CUTOFF 16
+
+/// <summary>
+///  Index of the median of three elements of an array
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="i"> First index </param>
+/// <param name="j"> Second index </param>
+/// <param name="k"> Third index </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+int medianOfThree(RandomIt unsArray, int i, int j, int k, Less lessThan)
+{
+    if (lessThan(unsArray[i], unsArray[j])) {
+        return lessThan(unsArray[j], unsArray[k]) ? j : (lessThan(unsArray[i], unsArray[k]) ? k : i);
+    }
+    return lessThan(unsArray[i], unsArray[k]) ? i : (lessThan(unsArray[j], unsArray[k]) ? k : j);
+}
+
+/// <summary>
+///  Pivot index: median of first, middle and last element, or Tukey's ninther (median of three medians)
+///  for partitions of 128 elements or more. Sorted and reverse-sorted inputs get the exact median
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="first"> First numer of array size (e.g., 0)</param>
+/// <param name="last"> Last number of array size (e.g., n)</param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+int choosePivot(RandomIt unsArray, int first, int last, Less lessThan)
+{
+    int middle = first + ((last - first) >> 1);
+    if (last - first + 1 < 128) {
+        return medianOfThree(unsArray, first, middle, last, lessThan);
+    }
+
+    int step = (last - first + 1) / 8;
+    int a = medianOfThree(unsArray, first, first + step, first + 2 * step, lessThan);
+    int b = medianOfThree(unsArray, middle - step, middle, middle + step, lessThan);
+    int c = medianOfThree(unsArray, last - 2 * step, last - step, last, lessThan);
+    return medianOfThree(unsArray, a, b, c, lessThan);
+}
+
+/// <summary>
+///  Dutch national flag (3-way) partition: elements less than, equal to and greater than the pivot
+///  Elements equal to the pivot are never visited again, so duplicate-heavy inputs stay O(n log n)
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="first"> First numer of array size (e.g., 0)</param>
+/// <param name="last"> Last number of array size (e.g., n)</param>
+/// <param name="pivotNumber"> Pivot value (a copy, elements move while partitioning) </param>
+/// <param name="equalFirst"> First position of the elements equal to the pivot </param>
+/// <param name="equalLast"> Last position of the elements equal to the pivot </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Value, typename Less>
+void partitionThreeWay(RandomIt unsArray, int first, int last, const Value& pivotNumber, int& equalFirst, int& equalLast, Less lessThan)
+{
+    int lessEnd = first, i = first, greaterBegin = last;
+
+    // Loop first,...,greaterBegin
+    while (i <= greaterBegin)
+    {
+        if (lessThan(unsArray[i], pivotNumber)) {
+            swap(unsArray[lessEnd++], unsArray[i++]);
+        }
+        else if (lessThan(pivotNumber, unsArray[i])) {
+            swap(unsArray[i], unsArray[greaterBegin--]);
+        }
+        else {
+            i++;
+        }
+    }
+
+    equalFirst = lessEnd;
+    equalLast = greaterBegin;
+}
+
+/// <summary>
+///  Introsort loop: quick sort on large partitions, heap sort once the depth limit is exhausted
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="first"> First numer of array size (e.g., 0)</param>
+/// <param name="last"> Last number of array size (e.g., n)</param>
+/// <param name="depthLimit"> Remaining partitioning levels before falling back to heap sort </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void introSortLoop(RandomIt unsArray, int first, int last, int depthLimit, Less lessThan)
+{
+    typedef typename iterator_traits<RandomIt>::value_type Value;
+    const int cutoff = NetworkSortable<Value, Less>::value ? SMALL_SORT_MAX : INSERTION_CUTOFF;
+    while (last - first + 1 > cutoff)
+    {
+        // Too many unbalanced partitions: heap sort guarantees O(n log n)
+        if (depthLimit-- == 0) {
+            heapSortRange(unsArray + first, last - first + 1, lessThan);
+            return;
+        }
+
+        auto pivotNumber = unsArray[choosePivot(unsArray, first, last, lessThan)];
+        int equalFirst, equalLast;
+        partitionThreeWay(unsArray, first, last, pivotNumber, equalFirst, equalLast, lessThan);
+
+        // Recurrent call for the smaller side, loop on the larger side (stack depth O(log n))
+        if (equalFirst - first < last - equalLast) {
+            introSortLoop(unsArray, first, equalFirst - 1, depthLimit, lessThan);
+            first = equalLast + 1;
+        }
+        else {
+            introSortLoop(unsArray, equalLast + 1, last, depthLimit, lessThan);
+            last = equalFirst - 1;
+        }
+    }
+
+    smallSortRange(unsArray + first, last - first + 1, lessThan);
+}
+
+/// <summary>
+///  Introsort of n elements with depth limit 2 * log2(n)
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void introSortRange(RandomIt unsArray, int n, Less lessThan)
+{
+    // Stopping criteria
+    if (n < 2) {
+        return;
+    }
+
+    int depthLimit = 0;
+    for (int size = n; size > 1; size >>= 1) {
+        depthLimit += 2;
+    }
+
+    introSortLoop(unsArray, 0, n - 1, depthLimit, lessThan);
+}
+
+/// <summary>
+///  Introsort of [first, last) by comp(proj(a), proj(b)), not stable
+/// </summary>
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void introSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    introSortRange(first, (int)(last - first), makeLess(comp, proj));
+}
+
+/// <summary>
+///  Quick sort algorithm (introsort)
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="first"> First numer of array size (e.g., 0)</param>
+/// <param name="last"> Last number of array size (e.g., n)</param>
+void quickSortAlgorithm(int unsArray[], int first, int last)
+{
+    // Stopping criteria
+    if (first >= last) {
+        return;
+    }
+
+    introSort(unsArray + first, unsArray + last + 1);
+}
+
+#pragma endregion
+
+#pragma region Merge Sort Algorithm (Bottom-Up)
+
+// Length of the runs sorted by insertion sort before the first merge pass (SMALL_SORT_MAX for sorting networks)
+#define MERGE_RUN_LENGTH 16
+
+/// <summary>
+///  Merges sorted arrays a and b into out, stable and without branches in the inner loop
+/// </summary>
+/// <param name="a"> Left sorted array </param>
+/// <param name="n"> Size of a </param>
+/// <param name="b"> Right sorted array </param>
+/// <param name="m"> Size of b </param>
+/// <param name="out"> Destination of n + m elements </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename InputIt, typename OutputIt, typename Less>
+void mergeArrays(InputIt a, int n, InputIt b, int m, OutputIt out, Less lessThan)
+{
+    int i = 0, j = 0, k = 0;
+
+    // The comparison result selects the element and advances one of the two indexes
+    while (i < n && j < m)
+    {
+        bool takeRight = lessThan(b[j], a[i]);     // Ties take the left element (stable)
+        out[k++] = move(takeRight ? b[j] : a[i]);
+        i += !takeRight;
+        j += takeRight;
+    }
+
+    // Move remaining elements
+    move(a + i, a + n, out + k);
+    move(b + j, b + m, out + k + (n - i));
+}
+
+/// <summary>
+///  Merges two sorted runs of src into dst
+///  Runs already in order (or in exactly reverse order) are moved without comparisons
+/// </summary>
+/// <param name="src"> Array holding both runs </param>
+/// <param name="dst"> Destination array </param>
+/// <param name="first"> First cell position of the left run </param>
+/// <param name="middle"> First cell position of the right run </param>
+/// <param name="last"> Cell position after the right run </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename InputIt, typename OutputIt, typename Less>
+void mergeRuns(InputIt src, OutputIt dst, int first, int middle, int last, Less lessThan)
+{
+    // Left run entirely before the right run: plain move
+    if (middle == last || !lessThan(src[middle], src[middle - 1])) {
+        move(src + first, src + last, dst + first);
+        return;
+    }
+
+    // Right run entirely before the left run: swap the runs
+    if (lessThan(src[last - 1], src[first])) {
+        move(src + middle, src + last, dst + first);
+        move(src + first, src + middle, dst + first + (last - middle));
+        return;
+    }
+
+    mergeArrays(src + first, middle - first, src + middle, last - middle, dst + first, lessThan);
+}
+
+/// <summary>
+///  Bottom-up merge sort of n elements
+///  Runs of MERGE_RUN_LENGTH are sorted in place, then every pass merges pairs of runs from one array into
+///  the other, alternating between unsArray and the buffer, so nothing is copied back between passes
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="buffer"> Scratch array of at least n elements, allocated when nullptr </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void mergeSortRange(RandomIt unsArray, int n, typename iterator_traits<RandomIt>::value_type* buffer, Less lessThan)
+{
+    typedef typename iterator_traits<RandomIt>::value_type Value;
+    if (n < 2) {
+        return;
+    }
+
+    vector<Value> ownBuffer;
+    if (buffer == nullptr) {
+        ownBuffer.resize(n);
+        buffer = ownBuffer.data();
+    }
+
+    // Sort the initial runs, with sorting networks when equal elements are indistinguishable
+    const int runLength = NetworkSortable<Value, Less>::value ? SMALL_SORT_MAX : MERGE_RUN_LENGTH;
+    for (int first = 0; first < n; first += runLength) {
+        smallSortRange(unsArray + first, min(runLength, n - first), lessThan);
+    }
+
+    // Merge passes, doubling the run width
+    bool inBuffer = false;
+    for (int width = runLength; width < n; width *= 2)
+    {
+        for (int first = 0; first < n; first += 2 * width) {
+            int middle = min(first + width, n);
+            int last = min(middle + width, n);
+            if (inBuffer) {
+                mergeRuns(buffer, unsArray, first, middle, last, lessThan);
+            }
+            else {
+                mergeRuns(unsArray, buffer, first, middle, last, lessThan);
+            }
+        }
+        inBuffer = !inBuffer;
+    }
+
+    // Odd number of passes: the result is in the buffer
+    if (inBuffer) {
+        move(buffer, buffer + n, unsArray);
+    }
+}
+
+/// <summary>
+///  Stable merge sort of [first, last) by comp(proj(a), proj(b))
+/// </summary>
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void mergeSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    mergeSortRange(first, (int)(last - first), nullptr, makeLess(comp, proj));
+}
+
+/// <summary>
+///  Merge sort algorithm (bottom-up)
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="buffer"> Scratch array of at least n numbers, allocated when nullptr </param>
+void mergeSortAlgorithm(int unsArray[], int n, int buffer[] = nullptr)
+{
+    mergeSortRange(unsArray, n, buffer, makeLess(less<>(), Identity()));
+}
+
+#pragma endregion
+
+#pragma region TimSort Algorithm (Powersort Merge Policy)
+
+// Consecutive wins of one run before a merge switches to galloping
+#define MIN_GALLOP 7
+
+/// <summary>
+///  Length of the natural run starting at first: non-descending, or strictly descending and then
+///  reversed in place (strict, so reversing never reorders equal elements)
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="first"> Start of the run </param>
+/// <param name="n"> Size of array </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+int countRunAndMakeAscending(RandomIt unsArray, int first, int n, Less lessThan)
+{
+    int last = first + 1;
+    if (last == n) {
+        return 1;
+    }
+
+    if (lessThan(unsArray[last], unsArray[first])) {
+        while (last + 1 < n && lessThan(unsArray[last + 1], unsArray[last])) {
+            last++;
+        }
+        reverse(unsArray + first, unsArray + last + 1);
+    }
+    else {
+        while (last + 1 < n && !lessThan(unsArray[last + 1], unsArray[last])) {
+            last++;
+        }
+    }
+    return last - first + 1;
+}
+
+/// <summary>
+///  Binary insertion sort of n elements whose first sorted elements are already in order: each element
+///  finds its place with a binary search (after equal elements, stable) and one block move
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="sorted"> Length of the sorted prefix </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void binaryInsertionSort(RandomIt unsArray, int n, int sorted, Less lessThan)
+{
+    for (int i = max(sorted, 1); i < n; i++)
+    {
+        int position = (int)(upper_bound(unsArray, unsArray + i, unsArray[i], lessThan) - unsArray);
+        if (position < i) {
+            auto number = move(unsArray[i]);
+            move_backward(unsArray + position, unsArray + i, unsArray + i + 1);
+            unsArray[position] = move(number);
+        }
+    }
+}
+
+/// <summary>
+///  Minimum run length for n elements, between 32 and 64, so that n / minRun is a power of two or
+///  slightly below one and the final merges stay balanced
+/// </summary>
+int minRunLength(int n)
+{
+    int remainder = 0;
+    while (n >= 64) {
+        remainder |= n & 1;
+        n >>= 1;
+    }
+    return n + remainder;
+}
+
+/// <summary>
+///  Powersort node power of the boundary between the runs [first, first + n1) and [first + n1, first + n1 + n2)
+///  of an array of size n: the depth of the first bit in which the run midpoints, as fractions of n, differ.
+///  Boundaries are merged deepest first, which keeps the merge tree within 2% of the optimal cost
+/// </summary>
+int nodePower(int first, int n1, int n2, int n)
+{
+    int64_t a = 2 * (int64_t)first + n1;      // 2 * midpoint of the left run
+    int64_t b = a + n1 + n2;                   // 2 * midpoint of the right run
+    int power = 0;
+    while (true)
+    {
+        power++;
+        if (a >= n) {
+            a -= n;
+            b -= n;
+        }
+        else if (b >= n) {
+            return power;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+}
+
+/// <summary>
+///  Length of the prefix of [x, x + n) in which every element satisfies inPrefix, by exponential search
+///  (1, 3, 7, ... elements) then binary search, O(log k) for a prefix of length k
+/// </summary>
+template <typename RandomIt, typename Predicate>
+int gallop(RandomIt x, int n, Predicate inPrefix)
+{
+    int low = 0, bound = 1;
+    while (bound <= n && inPrefix(x[bound - 1])) {
+        low = bound;
+        bound = 2 * bound + 1;
+    }
+    int high = min(bound - 1, n);
+    return (int)(partition_point(x + low, x + high, inPrefix) - x);
+}
+
+/// <summary>
+///  Merges the run x (moved to a buffer) with the run y that follows its original place, writing from dest.
+///  Elements are taken one at a time until one run wins minGallop times in a row; then whole blocks are
+///  located by galloping, so runs that barely interleave merge in O(log n) comparisons per block.
+///  Ties go to x (stable). Backward merges use reverse iterators and a reversed order
+/// </summary>
+/// <param name="dest"> Destination, starts where x was </param>
+/// <param name="x"> Buffered left run </param>
+/// <param name="lenX"> Length of x </param>
+/// <param name="y"> Right run, in place after the destination </param>
+/// <param name="lenY"> Length of y </param>
+/// <param name="minGallop"> Galloping threshold, adapted to the data </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename BufferIt, typename Less>
+void gallopingMerge(RandomIt dest, BufferIt x, int lenX, RandomIt y, int lenY, int& minGallop, Less lessThan)
+{
+    while (lenX > 0 && lenY > 0)
+    {
+        // One element at a time
+        int winsX = 0, winsY = 0;
+        while (lenX > 0 && lenY > 0 && max(winsX, winsY) < minGallop)
+        {
+            if (lessThan(*y, *x)) {
+                *dest++ = move(*y++);
+                lenY--;
+                winsY++;
+                winsX = 0;
+            }
+            else {
+                *dest++ = move(*x++);
+                lenX--;
+                winsX++;
+                winsY = 0;
+            }
+        }
+
+        // Galloping: blocks of x not after *y, then blocks of y before *x
+        while (lenX > 0 && lenY > 0)
+        {
+            int countX = gallop(x, lenX, [&](const auto& number) { return !lessThan(*y, number); });
+            dest = move(x, x + countX, dest);
+            x += countX;
+            lenX -= countX;
+            if (lenX == 0) {
+                break;
+            }
+
+            int countY = gallop(y, lenY, [&](const auto& number) { return lessThan(number, *x); });
+            dest = move(y, y + countY, dest);
+            y += countY;
+            lenY -= countY;
+
+            // Short blocks: galloping does not pay off, raise the threshold
+            if (countX < MIN_GALLOP && countY < MIN_GALLOP) {
+                minGallop++;
+                break;
+            }
+            minGallop = max(1, minGallop - 1);
+        }
+    }
+
+    // The rest of y is already in place
+    move(x, x + lenX, dest);
+}
+
+/// <summary>
+///  Merges the adjacent runs [first, first + lenA) and [first + lenA, first + lenA + lenB)
+///  The prefix of A not after B[0] and the suffix of B not before the last of A are already in place;
+///  only the shorter of the remaining runs is buffered, merged forward when it is A, backward when it is B
+/// </summary>
+template <typename RandomIt, typename Less>
+void mergeAdjacentRuns(RandomIt unsArray, int first, int lenA, int lenB, vector<typename iterator_traits<RandomIt>::value_type>& buffer, int& minGallop, Less lessThan)
+{
+    int middle = first + lenA;
+    int skip = gallop(unsArray + first, lenA, [&](const auto& number) { return !lessThan(unsArray[middle], number); });
+    first += skip;
+    lenA -= skip;
+    if (lenA == 0) {
+        return;
+    }
+    lenB = gallop(unsArray + middle, lenB, [&](const auto& number) { return lessThan(number, unsArray[middle - 1]); });
+    if (lenB == 0) {
+        return;
+    }
+
+    if (lenA <= lenB) {
+        buffer.assign(make_move_iterator(unsArray + first), make_move_iterator(unsArray + middle));
+        gallopingMerge(unsArray + first, buffer.begin(), lenA, unsArray + middle, lenB, minGallop, lessThan);
+    }
+    else {
+        typedef reverse_iterator<RandomIt> Backward;
+        buffer.assign(make_move_iterator(unsArray + middle), make_move_iterator(unsArray + middle + lenB));
+        gallopingMerge(Backward(unsArray + middle + lenB), buffer.rbegin(), lenB, Backward(unsArray + middle), lenA, minGallop,
+            [lessThan](const auto& a, const auto& b) { return lessThan(b, a); });
+    }
+}
+
+/// <summary>
+///  TimSort of n elements with the powersort merge policy, stable
+///  Natural runs are detected (descending ones reversed) and short runs are extended to minRun by binary
+///  insertion. Every new run computes the node power of its boundary with the previous run, and runs on
+///  the stack are merged while their boundary is deeper. Sorted or nearly sorted inputs are a few long runs
+///  and sort in close to O(n); random inputs stay O(n log n)
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void timSortRange(RandomIt unsArray, int n, Less lessThan)
+{
+    typedef typename iterator_traits<RandomIt>::value_type Value;
+    if (n < 2) {
+        return;
+    }
+
+    // Pending runs, power: node power of the boundary with the next run
+    struct Run
+    {
+        int first, length, power;
+    };
+    vector<Run> runs;
+    vector<Value> buffer;
+    int minGallop = MIN_GALLOP;
+    const int minRun = minRunLength(n);
+
+    auto mergeTopRuns = [&]() {
+        Run& left = runs[runs.size() - 2];
+        mergeAdjacentRuns(unsArray, left.first, left.length, runs.back().length, buffer, minGallop, lessThan);
+        left.length += runs.back().length;
+        runs.pop_back();
+    };
+
+    for (int first = 0; first < n; )
+    {
+        int length = countRunAndMakeAscending(unsArray, first, n, lessThan);
+        if (length < minRun) {
+            int extended = min(minRun, n - first);
+            binaryInsertionSort(unsArray + first, extended, length, lessThan);
+            length = extended;
+        }
+
+        if (!runs.empty()) {
+            int power = nodePower(runs.back().first, runs.back().length, length, n);
+            while (runs.size() > 1 && runs[runs.size() - 2].power > power) {
+                mergeTopRuns();
+            }
+            runs.back().power = power;
+        }
+        runs.push_back(Run{ first, length, 0 });
+        first += length;
+    }
+
+    while (runs.size() > 1) {
+        mergeTopRuns();
+    }
+}
+
+/// <summary>
+///  TimSort of [first, last) by comp(proj(a), proj(b)), stable and adaptive to existing order
+/// </summary>
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void timSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    timSortRange(first, (int)(last - first), makeLess(comp, proj));
+}
+
+/// <summary>
+///  TimSort algorithm (natural runs, powersort merges, galloping)
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+void timSortAlgorithm(int unsArray[], int n)
+{
+    timSort(unsArray, unsArray + n);
+}
+
+#pragma endregion
+
+#pragma region Bubble Sort Algorithm (Recursive)
+
+/// <summary>
+///  Bubble sort of n elements (recursive)
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void bubbleSortRange(RandomIt unsArray, int n, Less lessThan)
+{
+    // Loop 0,...,n-1
+    for (int i = 0; i < n - 1; i++)
+    {
+        // Swap positions if two continous values are unsorted
+        if (lessThan(unsArray[i + 1], unsArray[i])) {
+            swap(unsArray[i], unsArray[i + 1]);
+        }
+    }
+    // Recursive call with n-1
+    if (n - 1 > 1) {
+        bubbleSortRange(unsArray, n - 1, lessThan);
+    }
+}
+
+/// <summary>
+///  Bubble sort of [first, last) by comp(proj(a), proj(b))
+/// </summary>
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void bubbleSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    bubbleSortRange(first, (int)(last - first), makeLess(comp, proj));
+}
+
+/// <summary>
+///  Bubble sort algorithm (Recursive)
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+void bubbleSortAlgorithm(int unsArray[], int n)
+{
+    bubbleSort(unsArray, unsArray + n);
+}
+#pragma endregion
+
+#pragma region Selection Sort Algrithm
+
+/// <summary>
+///  Selection sort of n elements
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void selectionSortRange(RandomIt unsArray, int n, Less lessThan)
+{
+    // 1st Loop 0,...,n-1
+    for (int i = 0; i < n - 1; i++)
+    {
+        // Identify minimum number from unsArray[i,...,n-1]
+        int minNumber = i;
+
+        // 2nd Loop i+1,...,n-1
+        for (int j = i + 1; j < n; j++)
+        {
+            // Identify index of the minimum from 2nd Loop
+            if (lessThan(unsArray[j], unsArray[minNumber])) {
+                minNumber = j;
+            }
+        }
+
+        // Swap two numbers of an array based on the provided indexes
+        swap(unsArray[minNumber], unsArray[i]);
+    }
+}
+
+/// <summary>
+///  Selection sort of [first, last) by comp(proj(a), proj(b))
+/// </summary>
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void selectionSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    selectionSortRange(first, (int)(last - first), makeLess(comp, proj));
+}
+
+/// <summary>
+///  Selection sort algorithm
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+void selectionSortAlgorithm(int unsArray[], int n)
+{
+    selectionSort(unsArray, unsArray + n);
+}
+
+#pragma endregion
+
+#pragma region Insertion Sort Algorithm
+
+/// <summary>
+///  Insertion sort of n elements (stable)
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void insertionSortRange(RandomIt unsArray, int n, Less lessThan)
+{
+    // Loop 1,...,n
+    for (int i = 1; i < n; i++)
+    {
+        // Save the ith unsorted element and set the j index
+        auto number = move(unsArray[i]);
+        int j = i;
+
+        // Identify the position the element belongs to in the sorted array
+        while (j > 0 && lessThan(number, unsArray[j - 1]))
+        {
+            unsArray[j] = move(unsArray[j - 1]);
+            j--;
+        }
+
+        // Update element to the identified position
+        unsArray[j] = move(number);
+    }
+}
+
+/// <summary>
+///  Insertion sort of [first, last) by comp(proj(a), proj(b))
+/// </summary>
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void insertionSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    insertionSortRange(first, (int)(last - first), makeLess(comp, proj));
+}
+
+/// <summary>
+///  Insertion sort algorithm
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+void insertionSortAlgorithm(int unsArray[], int n)
+{
+    insertionSort(unsArray, unsArray + n);
+}
+#pragma endregion
+
+#pragma region Selection (nth Element, Partial Sort, Top-k)
+
+// Ranges above this size pick the pivot by Floyd-Rivest sampling
+#define FLOYD_RIVEST_CUTOFF 600
+
+/// <summary>
+///  Selection loop: moves the k-th smallest element to position k, smaller elements before it and
+///  larger ones after it. Large ranges select k recursively in a window of about n^(2/3) elements
+///  around k (Floyd-Rivest), so the pivot lands next to the k-th element and each pass discards most
+///  of the range; smaller ranges use the introsort pivot. Only the side holding k is kept, O(n) expected.
+///  Once the depth limit is exhausted the range is heap sorted, O(n log n) in the worst case
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="first"> First position of the range </param>
+/// <param name="last"> Last position of the range </param>
+/// <param name="k"> Position to select (first <= k <= last) </param>
+/// <param name="depthLimit"> Remaining partitioning levels before falling back to heap sort </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void selectLoop(RandomIt unsArray, int first, int last, int k, int depthLimit, Less lessThan)
+{
+    while (last - first + 1 > SMALL_SORT_MAX)
+    {
+        if (depthLimit-- == 0) {
+            heapSortRange(unsArray + first, last - first + 1, lessThan);
+            return;
+        }
+
+        int pivot;
+        if (last - first + 1 > FLOYD_RIVEST_CUTOFF) {
+            double size = last - first + 1, rank = k - first + 1;
+            double z = log(size);
+            double sampleSize = 0.5 * exp(2 * z / 3);
+            double deviation = 0.5 * sqrt(z * sampleSize * (size - sampleSize) / size) * (rank < size / 2 ? -1 : 1);
+            int sampleFirst = max(first, min(k, (int)(k - rank * sampleSize / size + deviation)));
+            int sampleLast = min(last, max(k, (int)(k + (size - rank) * sampleSize / size + deviation)));
+            selectLoop(unsArray, sampleFirst, sampleLast, k, depthLimit, lessThan);
+            pivot = k;
+        }
+        else {
+            pivot = choosePivot(unsArray, first, last, lessThan);
+        }
+
+        auto pivotNumber = unsArray[pivot];
+        int equalFirst, equalLast;
+        partitionThreeWay(unsArray, first, last, pivotNumber, equalFirst, equalLast, lessThan);
+
+        if (k < equalFirst) {
+            last = equalFirst - 1;
+        }
+        else if (k > equalLast) {
+            first = equalLast + 1;
+        }
+        else {
+            return;
+        }
+    }
+
+    smallSortRange(unsArray + first, last - first + 1, lessThan);
+}
+
+/// <summary>
+///  nth element of n elements: position k receives the element of a sorted array, O(n) expected
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="k"> Position to select </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void nthElementRange(RandomIt unsArray, int n, int k, Less lessThan)
+{
+    if (k < 0 || k >= n) {
+        return;
+    }
+
+    int depthLimit = 0;
+    for (int size = n; size > 1; size >>= 1) {
+        depthLimit += 2;
+    }
+
+    selectLoop(unsArray, 0, n - 1, k, depthLimit, lessThan);
+}
+
+/// <summary>
+///  nth element of [first, last) by comp(proj(a), proj(b)), e.g. the median with nth = first + n / 2
+/// </summary>
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void nthElement(RandomIt first, RandomIt nth, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    nthElementRange(first, (int)(last - first), (int)(nth - first), makeLess(comp, proj));
+}
+
+/// <summary>
+///  Partial sort: the smallest middle - first elements of [first, last) in sorted order at the front,
+///  the rest in any order. Selection then a sort of the prefix, O(n + k log k)
+/// </summary>
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void partialSort(RandomIt first, RandomIt middle, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    auto lessThan = makeLess(comp, proj);
+    int n = (int)(last - first), k = (int)(middle - first);
+    if (k <= 0) {
+        return;
+    }
+
+    if (k < n) {
+        nthElementRange(first, n, k - 1, lessThan);
+    }
+    introSortRange(first, k, lessThan);
+}
+
+// Class for the k smallest values of a stream of unknown length (k largest with greater<>())
+// A max-heap keeps the current k best with the worst of them on top, so a value that does not make the
+// cut costs one comparison, and the memory stays O(k) however long the stream is
+template <typename T, typename Compare = less<>, typename Projection = Identity>
+class TopK
+{
+    int k;
+    vector<T> heap;
+    ProjectedLess<Compare, Projection> lessThan;
+
+public:
+
+    TopK(int k, Compare comp = Compare(), Projection proj = Projection()) : k(max(0, k)), lessThan(makeLess(comp, proj))
+    {
+        heap.reserve(this->k);
+    }
+
+    // Offers a value: O(1) when it is worse than the current k best, O(log k) otherwise
+    void push(const T& value)
+    {
+        if ((int)heap.size() < k)
+        {
+            // Sift the new value up
+            int child = (int)heap.size();
+            heap.push_back(value);
+            T number = move(heap[child]);
+            while (child > 0)
+            {
+                int parent = (child - 1) / 2;
+                if (!lessThan(heap[parent], number)) {
+                    break;
+                }
+                heap[child] = move(heap[parent]);
+                child = parent;
+            }
+            heap[child] = move(number);
+        }
+        else if (k > 0 && lessThan(value, heap[0])) {
+            heap[0] = value;
+            siftDown(heap.begin(), 0, k, lessThan);
+        }
+    }
+
+    // Number of values kept (k once the stream has k values)
+    int size() const { return (int)heap.size(); }
+
+    // Worst of the kept values, the bar a new value has to beat
+    const T& threshold() const { return heap[0]; }
+
+    // Kept values in sorted order, O(k log k)
+    vector<T> sorted() const
+    {
+        vector<T> result(heap);
+        heapSortRange(result.begin(), (int)result.size(), lessThan);
+        return result;
+    }
+};
+
+/// <summary>
+///  nth element algorithm: unsArray[k] receives the k-th smallest number
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="k"> Position to select </param>
+void nthElementAlgorithm(int unsArray[], int n, int k)
+{
+    nthElement(unsArray, unsArray + k, unsArray + n);
+}
+
+/// <summary>
+///  Partial sort algorithm: the k smallest numbers in sorted order at the front
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="k"> Number of sorted numbers </param>
+void partialSortAlgorithm(int unsArray[], int n, int k)
+{
+    partialSort(unsArray, unsArray + k, unsArray + n);
+}
+
+#pragma endregion
+
+#pragma region Work-Stealing Thread Pool
+
+// Class for a pool of worker threads, each with its own task deque
+// A worker runs its newest task first (depth first, cache warm) and steals the oldest task of another
+// worker when its deque is empty; a thread waiting on a TaskGroup runs pending tasks instead of blocking
+class ThreadPool
+{
+    // Task deque of one worker
+    struct Worker
+    {
+        deque<function<void()> > tasks;
+        mutex lock;
+    };
+
+    vector<unique_ptr<Worker> > workers;
+    vector<thread> threads;
+    atomic<bool> stopping;
+
+    // Tasks waiting in all deques, and sleeping workers
+    atomic<int> queued;
+    mutex sleepMutex;
+    condition_variable wake;
+
+    // Index of the worker running on this thread, -1 outside the pool
+    static thread_local int currentWorker;
+
+    // Round-robin deque for tasks submitted from outside the pool
+    atomic<unsigned int> nextExternal;
+
+    // Worker loop
+    void workerLoop(int self);
+
+public:
+
+    // Constructor, threadCount 0 uses one worker per hardware thread
+    ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    // Number of workers
+    int size() const { return (int)workers.size(); }
+
+    // Queues a task on the calling worker's deque (or on any deque from outside the pool)
+    void submit(function<void()> task);
+
+    // Runs one pending task, own deque first, then stealing; returns false if none was found
+    bool runPending();
+
+    // Pool shared by the parallel sorting algorithms
+    static ThreadPool& shared();
+};
+
+thread_local int ThreadPool::currentWorker = -1;
+
+ThreadPool::ThreadPool(int threadCount) : stopping(false), queued(0), nextExternal(0)
+{
+    if (threadCount <= 0) {
+        threadCount = (int)max(1u, thread::hardware_concurrency());
+    }
+    for (int t = 0; t < threadCount; t++) {
+        workers.push_back(unique_ptr<Worker>(new Worker()));
+    }
+    for (int t = 0; t < threadCount; t++) {
+        threads.push_back(thread(&ThreadPool::workerLoop, this, t));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> guard(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (size_t t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+}
+
+void ThreadPool::submit(function<void()> task)
+{
+    int target = currentWorker >= 0 ? currentWorker : (int)(nextExternal++ % workers.size());
+    {
+        lock_guard<mutex> guard(workers[target]->lock);
+        workers[target]->tasks.push_back(move(task));
+    }
+    queued++;
+
+    // Taking the sleep lock orders the notification after a worker's check of queued
+    {
+        lock_guard<mutex> guard(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+bool ThreadPool::runPending()
+{
+    function<void()> task;
+    int self = currentWorker;
+
+    // Own deque, newest task
+    if (self >= 0) {
+        lock_guard<mutex> guard(workers[self]->lock);
+        if (!workers[self]->tasks.empty()) {
+            task = move(workers[self]->tasks.back());
+            workers[self]->tasks.pop_back();
+        }
+    }
+
+    // Steal the oldest task of the other deques
+    int count = (int)workers.size();
+    int start = self >= 0 ? self + 1 : 0;
+    for (int k = 0; !task && k < count; k++) {
+        int victim = (start + k) % count;
+        if (victim == self) {
+            continue;
+        }
+        lock_guard<mutex> guard(workers[victim]->lock);
+        if (!workers[victim]->tasks.empty()) {
+            task = move(workers[victim]->tasks.front());
+            workers[victim]->tasks.pop_front();
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+    queued--;
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(int self)
+{
+    currentWorker = self;
+    while (true)
+    {
+        if (runPending()) {
+            continue;
+        }
+        unique_lock<mutex> guard(sleepMutex);
+        wake.wait(guard, [this] { return stopping || queued > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+// Class for a group of tasks that can be waited on
+class TaskGroup
+{
+    ThreadPool& pool;
+    atomic<int> pending;
+
+public:
+
+    TaskGroup(ThreadPool& pool) : pool(pool), pending(0) {}
+
+    // Queues a task of the group
+    void run(function<void()> task)
+    {
+        pending++;
+        pool.submit([this, task] {
+            task();
+            pending--;
+        });
+    }
+
+    // Returns when every task of the group has finished, running pending tasks meanwhile
+    void wait()
+    {
+        while (pending > 0) {
+            if (!pool.runPending()) {
+                this_thread::yield();
+            }
+        }
+    }
+};
+
+/// <summary>
+///  Splits [begin, end) into blocks and runs work(blockBegin, blockEnd) on the pool, the calling
+///  thread runs the last block and helps with the others until all are done
+/// </summary>
+/// <param name="pool"> Thread pool </param>
+/// <param name="begin"> First index </param>
+/// <param name="end"> Index after the last </param>
+/// <param name="blocks"> Number of blocks </param>
+/// <param name="work"> Work on one block </param>
+void parallelFor(ThreadPool& pool, int begin, int end, int blocks, const function<void(int, int)>& work)
+{
+    blocks = max(1, min(blocks, end - begin));
+    TaskGroup group(pool);
+    for (int b = 0; b < blocks - 1; b++) {
+        int blockBegin = begin + (int)((int64_t)(end - begin) * b / blocks);
+        int blockEnd = begin + (int)((int64_t)(end - begin) * (b + 1) / blocks);
+        group.run([&work, blockBegin, blockEnd] { work(blockBegin, blockEnd); });
+    }
+    work(begin + (int)((int64_t)(end - begin) * (blocks - 1) / blocks), end);
+    group.wait();
+}
+
+#pragma endregion
+
+#pragma region Parallel Sorting Algorithms
+
+// Ranges up to this size are sorted sequentially
+#define PARALLEL_SORT_CUTOFF 16384
+
+/// <summary>
+///  Co-rank of output position k when merging a (size n) and b (size m): the number i of elements taken
+///  from a, so a[0, i) and b[0, k - i) are exactly the first k merged elements (ties from a first)
+/// </summary>
+/// <param name="k"> Output position </param>
+/// <param name="a"> Left sorted array </param>
+/// <param name="n"> Size of a </param>
+/// <param name="b"> Right sorted array </param>
+/// <param name="m"> Size of b </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename InputIt, typename Less>
+int coRank(int k, InputIt a, int n, InputIt b, int m, Less lessThan)
+{
+    int low = max(0, k - m), high = min(k, n);
+    while (true)
+    {
+        int i = low + ((high - low) >> 1);
+        int j = k - i;
+        if (i < n && j > 0 && !lessThan(b[j - 1], a[i])) {
+            low = i + 1;        // b[j - 1] must come after a[i]: take more from a
+        }
+        else if (i > 0 && j < m && lessThan(b[j], a[i - 1])) {
+            high = i - 1;       // a[i - 1] must come after b[j]: take less from a
+        }
+        else {
+            return i;
+        }
+    }
+}
+
+/// <summary>
+///  Parallel merge: the output is cut into equal chunks and the co-rank of every cut splits the inputs,
+///  so every chunk is an independent sequential merge
+/// </summary>
+/// <param name="pool"> Thread pool </param>
+/// <param name="a"> Left sorted array </param>
+/// <param name="n"> Size of a </param>
+/// <param name="b"> Right sorted array </param>
+/// <param name="m"> Size of b </param>
+/// <param name="out"> Destination of n + m elements </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename InputIt, typename OutputIt, typename Less>
+void parallelMerge(ThreadPool& pool, InputIt a, int n, InputIt b, int m, OutputIt out, Less lessThan)
+{
+    int total = n + m;
+    int chunks = max(1, min(4 * pool.size(), total / PARALLEL_SORT_CUTOFF));
+    parallelFor(pool, 0, chunks, chunks, [&](int chunkBegin, int chunkEnd) {
+        for (int c = chunkBegin; c < chunkEnd; c++) {
+            int k0 = (int)((int64_t)total * c / chunks), k1 = (int)((int64_t)total * (c + 1) / chunks);
+            int i0 = coRank(k0, a, n, b, m, lessThan), i1 = coRank(k1, a, n, b, m, lessThan);
+            mergeArrays(a + i0, i1 - i0, b + (k0 - i0), (k1 - i1) - (k0 - i0), out + k0, lessThan);
+        }
+    });
+}
+
+/// <summary>
+///  Task-parallel merge sort: the halves are sorted as two tasks into the other array, then merged back
+///  in parallel. Arrays alternate with the recursion level, so no copy-back is needed
+/// </summary>
+/// <param name="pool"> Thread pool </param>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="buffer"> Scratch array of the same size </param>
+/// <param name="n"> Size of array </param>
+/// <param name="resultInArray"> true: sorted elements end in unsArray, false: in buffer </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void parallelMergeSortTask(ThreadPool& pool, RandomIt unsArray, typename iterator_traits<RandomIt>::value_type* buffer, int n, bool resultInArray, Less lessThan)
+{
+    if (n <= PARALLEL_SORT_CUTOFF) {
+        mergeSortRange(unsArray, n, buffer, lessThan);
+        if (!resultInArray) {
+            move(unsArray, unsArray + n, buffer);
+        }
+        return;
+    }
+
+    int half = n / 2;
+    TaskGroup group(pool);
+    group.run([&pool, unsArray, buffer, half, resultInArray, lessThan] {
+        parallelMergeSortTask(pool, unsArray, buffer, half, !resultInArray, lessThan);
+    });
+    parallelMergeSortTask(pool, unsArray + half, buffer + half, n - half, !resultInArray, lessThan);
+    group.wait();
+
+    // Halves are sorted in the other array
+    if (resultInArray) {
+        parallelMerge(pool, buffer, half, buffer + half, n - half, unsArray, lessThan);
+    }
+    else {
+        parallelMerge(pool, unsArray, half, unsArray + half, n - half, buffer, lessThan);
+    }
+}
+
+/// <summary>
+///  Stable parallel merge sort of [first, last) by comp(proj(a), proj(b))
+/// </summary>
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void parallelMergeSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    typedef typename iterator_traits<RandomIt>::value_type Value;
+    int n = (int)(last - first);
+    vector<Value> buffer(max(n, 0));
+    parallelMergeSortTask(ThreadPool::shared(), first, buffer.data(), n, true, makeLess(comp, proj));
+}
+
+/// <summary>
+///  Parallel merge sort algorithm
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+void parallelMergeSortAlgorithm(int unsArray[], int n)
+{
+    parallelMergeSort(unsArray, unsArray + n);
+}
+
+/// <summary>
+///  Parallel sample sort of n elements
+///  Sorted samples give S unique splitters and 2S + 1 buckets: ranges between splitters and one bucket
+///  per splitter value, so duplicate-heavy inputs stay balanced and equal buckets need no sorting.
+///  Every block counts its bucket sizes, the prefix sums give each block its own output slots, and the
+///  scatter and the bucket sorts run in parallel without synchronisation
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename RandomIt, typename Less>
+void parallelSampleSortRange(RandomIt unsArray, int n, Less lessThan)
+{
+    typedef typename iterator_traits<RandomIt>::value_type Value;
+    ThreadPool& pool = ThreadPool::shared();
+    if (n <= PARALLEL_SORT_CUTOFF) {
+        introSortRange(unsArray, n, lessThan);
+        return;
+    }
+
+    // Evenly spread samples, oversampled 32 times
+    const int oversample = 32;
+    int splitterTarget = 4 * pool.size();
+    int sampleCount = min(n, (splitterTarget + 1) * oversample);
+    vector<Value> samples(sampleCount);
+    for (int s = 0; s < sampleCount; s++) {
+        samples[s] = unsArray[(int)((int64_t)n * s / sampleCount + (s * 7919) % max(1, n / sampleCount))];
+    }
+    introSortRange(samples.begin(), sampleCount, lessThan);
+
+    vector<Value> splitters;
+    for (int s = oversample; s < sampleCount; s += oversample) {
+        if (splitters.empty() || lessThan(splitters.back(), samples[s])) {
+            splitters.push_back(samples[s]);
+        }
+    }
+    const int S = (int)splitters.size();
+    const int buckets = 2 * S + 1;
+
+    // Bucket of an element: 2j for the range below splitter j, 2j + 1 for elements equal to splitter j
+    auto bucketOf = [&splitters, S, &lessThan](const Value& number) {
+        int j = (int)(lower_bound(splitters.begin(), splitters.end(), number, lessThan) - splitters.begin());
+        return (j < S && !lessThan(number, splitters[j])) ? 2 * j + 1 : 2 * j;
+    };
+
+    // Per-block bucket counts
+    const int blocks = 4 * pool.size();
+    vector<int> counts((size_t)blocks * buckets, 0);
+    parallelFor(pool, 0, blocks, blocks, [&](int blockBegin, int blockEnd) {
+        for (int block = blockBegin; block < blockEnd; block++) {
+            int* count = counts.data() + (size_t)block * buckets;
+            int first = (int)((int64_t)n * block / blocks), last = (int)((int64_t)n * (block + 1) / blocks);
+            for (int i = first; i < last; i++) {
+                count[bucketOf(unsArray[i])]++;
+            }
+        }
+    });
+
+    // Bucket-major prefix sums: block b writes bucket k from offsets[b][k] on
+    vector<int> offsets((size_t)blocks * buckets);
+    vector<int> bucketStart(buckets + 1, 0);
+    int position = 0;
+    for (int k = 0; k < buckets; k++) {
+        bucketStart[k] = position;
+        for (int block = 0; block < blocks; block++) {
+            offsets[(size_t)block * buckets + k] = position;
+            position += counts[(size_t)block * buckets + k];
+        }
+    }
+    bucketStart[buckets] = n;
+
+    vector<Value> buffer(n);
+    parallelFor(pool, 0, blocks, blocks, [&](int blockBegin, int blockEnd) {
+        for (int block = blockBegin; block < blockEnd; block++) {
+            int* offset = offsets.data() + (size_t)block * buckets;
+            int first = (int)((int64_t)n * block / blocks), last = (int)((int64_t)n * (block + 1) / blocks);
+            for (int i = first; i < last; i++) {
+                buffer[offset[bucketOf(unsArray[i])]++] = move(unsArray[i]);
+            }
+        }
+    });
+
+    // Sort the range buckets and move every bucket back, one task per bucket
+    parallelFor(pool, 0, buckets, buckets, [&](int bucketBegin, int bucketEnd) {
+        for (int k = bucketBegin; k < bucketEnd; k++) {
+            int first = bucketStart[k], last = bucketStart[k + 1];
+            if (k % 2 == 0) {
+                introSortRange(buffer.begin() + first, last - first, lessThan);
+            }
+            move(buffer.begin() + first, buffer.begin() + last, unsArray + first);
+        }
+    });
+}
+
+/// <summary>
+///  Parallel sample sort of [first, last) by comp(proj(a), proj(b)), not stable
+/// </summary>
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void parallelSampleSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    parallelSampleSortRange(first, (int)(last - first), makeLess(comp, proj));
+}
+
+/// <summary>
+///  Parallel sample sort algorithm
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+void parallelSampleSortAlgorithm(int unsArray[], int n)
+{
+    parallelSampleSort(unsArray, unsArray + n);
+}
+
+#pragma endregion
+
+#pragma region Radix Sort Algorithm (LSD)
+
+// Digit width of the radix sort
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+
+/// <summary>
+///  LSD radix sort of integer keys, moving an optional payload with every key (stable)
+///  Keys are sorted by their offset from the minimum key: signed keys need no sign handling and only
+///  the digits of max - min are sorted (one pass for keys within 256 of each other). A pass whose
+///  digit is the same for every key is skipped. Every block counts its digits and scatters to its own
+///  slots, so both loops of every pass run in parallel
+/// </summary>
+/// <param name="keys"> Integer keys </param>
+/// <param name="values"> Payload of every key, or nullptr </param>
+/// <param name="n"> Size of arrays </param>
+template <typename Key, typename Value>
+void radixSortPairs(Key keys[], Value values[], int n)
+{
+    typedef typename make_unsigned<Key>::type Digits;
+    if (n < 2) {
+        return;
+    }
+
+    ThreadPool& pool = ThreadPool::shared();
+    const int blocks = n >= PARALLEL_SORT_CUTOFF ? 2 * pool.size() : 1;
+    auto blockFirst = [n, blocks](int block) { return (int)((int64_t)n * block / blocks); };
+
+    // Key range
+    vector<Key> blockMin(blocks, keys[0]), blockMax(blocks, keys[0]);
+    parallelFor(pool, 0, blocks, blocks, [&](int blockBegin, int blockEnd) {
+        for (int block = blockBegin; block < blockEnd; block++) {
+            for (int i = blockFirst(block); i < blockFirst(block + 1); i++) {
+                blockMin[block] = min(blockMin[block], keys[i]);
+                blockMax[block] = max(blockMax[block], keys[i]);
+            }
+        }
+    });
+    const Key minKey = *min_element(blockMin.begin(), blockMin.end());
+    const Key maxKey = *max_element(blockMax.begin(), blockMax.end());
+
+    // Only the digits of the range are sorted
+    int passes = 0;
+    for (Digits range = (Digits)((Digits)maxKey - (Digits)minKey); range != 0; range >>= RADIX_BITS) {
+        passes++;
+    }
+
+    vector<Key> keyBuffer(passes > 0 ? n : 0);
+    vector<Value> valueBuffer(passes > 0 && values != nullptr ? n : 0);
+    Key* keySrc = keys;
+    Key* keyDst = keyBuffer.data();
+    Value* valueSrc = values;
+    Value* valueDst = valueBuffer.data();
+
+    // Bucket counts of every block, turned into scatter offsets
+    vector<int> counts((size_t)blocks * RADIX_BUCKETS);
+
+    for (int pass = 0; pass < passes; pass++)
+    {
+        const int shift = pass * RADIX_BITS;
+        auto digitOf = [minKey, shift](Key key) {
+            return (int)(((Digits)((Digits)key - (Digits)minKey) >> shift) & (RADIX_BUCKETS - 1));
+        };
+
+        fill(counts.begin(), counts.end(), 0);
+        parallelFor(pool, 0, blocks, blocks, [&](int blockBegin, int blockEnd) {
+            for (int block = blockBegin; block < blockEnd; block++) {
+                int* count = counts.data() + (size_t)block * RADIX_BUCKETS;
+                for (int i = blockFirst(block); i < blockFirst(block + 1); i++) {
+                    count[digitOf(keySrc[i])]++;
+                }
+            }
+        });
+
+        // Bucket-major prefix sums; a digit shared by all keys moves nothing
+        bool skip = false;
+        int position = 0;
+        for (int digit = 0; digit < RADIX_BUCKETS && !skip; digit++) {
+            int bucketFirst = position;
+            for (int block = 0; block < blocks; block++) {
+                int count = counts[(size_t)block * RADIX_BUCKETS + digit];
+                counts[(size_t)block * RADIX_BUCKETS + digit] = position;
+                position += count;
+            }
+            skip = position - bucketFirst == n;
+        }
+        if (skip) {
+            continue;
+        }
+
+        parallelFor(pool, 0, blocks, blocks, [&](int blockBegin, int blockEnd) {
+            for (int block = blockBegin; block < blockEnd; block++) {
+                int* offset = counts.data() + (size_t)block * RADIX_BUCKETS;
+                for (int i = blockFirst(block); i < blockFirst(block + 1); i++) {
+                    int slot = offset[digitOf(keySrc[i])]++;
+                    keyDst[slot] = keySrc[i];
+                    if (values != nullptr) {
+                        valueDst[slot] = valueSrc[i];
+                    }
+                }
+            }
+        });
+        swap(keySrc, keyDst);
+        swap(valueSrc, valueDst);
+    }
+
+    // Odd number of scatters: the result is in the buffers
+    if (keySrc != keys) {
+        parallelFor(pool, 0, blocks, blocks, [&](int blockBegin, int blockEnd) {
+            copy(keySrc + blockFirst(blockBegin), keySrc + blockFirst(blockEnd), keys + blockFirst(blockBegin));
+            if (values != nullptr) {
+                copy(valueSrc + blockFirst(blockBegin), valueSrc + blockFirst(blockEnd), values + blockFirst(blockBegin));
+            }
+        });
+    }
+}
+
+/// <summary>
+///  Radix sort algorithm (LSD)
+/// </summary>
+/// <param name="unsArray"> Unsorted array </param>
+/// <param name="n"> Size of array </param>
+void radixSortAlgorithm(int unsArray[], int n)
+{
+    radixSortPairs(unsArray, (int*)nullptr, n);
+}
+
+#pragma endregion
+
+#pragma region Index Sort (Argsort)
+
+/// <summary>
+///  Index sort: positions of [first, last) in sorted order, the elements themselves are not moved
+///  Sorts int indexes with the projection applied through them, stable (equal keys keep their order)
+/// </summary>
+/// <param name="first"> First element </param>
+/// <param name="last"> Element after the last </param>
+/// <param name="comp"> Comparator </param>
+/// <param name="proj"> Projection </param>
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+vector<int> argSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    vector<int> index((int)(last - first));
+    for (int i = 0; i < (int)index.size(); i++) {
+        index[i] = i;
+    }
+
+    auto keyOf = [first, proj](int i) -> decltype(auto) { return invoke(proj, first[i]); };
+    mergeSort(index.begin(), index.end(), comp, keyOf);
+    return index;
+}
+
+// Candidate facility of the facility location problem
+struct Facility
+{
+    int id;             // Facility index
+    double fixedCost;   // Fixed opening cost f[i]
+    int capacity;       // Capacity
+};
+
+/// <summary>
+///  Sorts facility records by a member with a projection, and ranks them with an argsort
+/// </summary>
+void sortFacilitiesExample()
+{
+    Facility facilities[] = { { 0, 120.5, 40 },
+                              { 1, 80.0, 25 },
+                              { 2, 150.25, 60 },
+                              { 3, 80.0, 30 },
+                              { 4, 95.75, 35 } };
+
+    cout << "Facilities ranked by capacity, largest first (argsort, records are not moved):" << endl;
+    vector<int> rank = argSort(begin(facilities), end(facilities), greater<>(), &Facility::capacity);
+    for (size_t i = 0; i < rank.size(); i++) {
+        cout << "Facility " << facilities[rank[i]].id << ": capacity " << facilities[rank[i]].capacity << endl;
+    }
+
+    cout << "Facilities sorted by fixed cost (stable merge sort, projection on fixedCost):" << endl;
+    mergeSort(begin(facilities), end(facilities), less<>(), &Facility::fixedCost);
+    for (size_t i = 0; i < size(facilities); i++) {
+        cout << "Facility " << facilities[i].id << ": fixed cost " << facilities[i].fixedCost << endl;
+    }
+}
+
 #pragma endregion
 
-#pragma region Quick Sort Algorithm
+#pragma region External Merge Sort
+
+// Settings of the external merge sort
+struct ExternalSortOptions
+{
+    size_t memoryBytes;         // Memory for a sorted run, and for all merge buffers together
+    size_t blockBytes;          // Size of one read or write (at most a sixth of memoryBytes)
+    string tempDirectory;       // Directory of the run files
+    uint64_t tempBytes;         // Most bytes the run files may take at once, the input size plus one merged group
+
+    ExternalSortOptions() : memoryBytes((size_t)256 << 20), blockBytes((size_t)4 << 20), tempDirectory("."), tempBytes(UINT64_MAX) {}
+};
+
+// Prefix of the run files of one external sort, unique among the sorts of every process sharing the directory
+inline string runFilePrefix(const string& directory)
+{
+    static atomic<unsigned int> sorts(0);
+#ifdef _WIN32
+    int process = _getpid();
+#else
+    int process = (int)getpid();
+#endif
+    return directory + "/sort_" + to_string(process) + "_" + to_string(sorts++) + "_run_";
+}
+
+// Class for reading a run file block by block, the next block is read in the background
+template <typename T>
+class RunReader
+{
+    FILE* file;
+    vector<T> current, next;        // Block being consumed and block being read
+    size_t position, count;         // Read position and size of the current block
+    future<size_t> pending;         // Read of the next block
+    bool failed;                    // A read stopped on an error instead of the end of the file
+
+    // Starts reading the next block
+    void readAhead()
+    {
+        FILE* source = file;
+        T* target = next.data();
+        size_t records = next.size();
+        pending = async(launch::async, [source, target, records] { return fread(target, sizeof(T), records, source); });
+    }
+
+public:
+
+    RunReader(const string& path, size_t blockRecords) : current(blockRecords), next(blockRecords), position(0), count(0), failed(false)
+    {
+        file = fopen(path.c_str(), "rb");
+        if (file != NULL) {
+            setvbuf(file, NULL, _IONBF, 0);     // Blocks are already large, skip the stdio copy
+            readAhead();
+            refill();
+        }
+    }
+
+    ~RunReader()
+    {
+        if (pending.valid()) {
+            pending.wait();
+        }
+        if (file != NULL) {
+            fclose(file);
+        }
+    }
+
+    bool isOpen() const { return file != NULL; }
+
+    // true if a read failed, the records consumed so far are then only a prefix of the run
+    bool readFailed() const { return failed; }
+
+    // true once every record has been consumed
+    bool empty() const { return position == count; }
+
+    // Current record
+    const T& front() const { return current[position]; }
+
+    // Moves to the next record
+    void pop()
+    {
+        if (++position == count) {
+            refill();
+        }
+    }
+
+    // Swaps in the block read in the background and starts reading the one after
+    // A short block is the end of the file unless the stream reports an error
+    void refill()
+    {
+        size_t records = pending.get();
+        if (records < next.size() && ferror(file)) {
+            failed = true;
+            records = 0;
+        }
+        swap(current, next);
+        position = 0;
+        count = records;
+        if (records > 0) {
+            readAhead();
+        }
+    }
+};
 
-/// <summary>
-///  Lomuto partition scheme: Last number of array is pivot and partitions (left and right) according to it
-/// </summary>
-/// <param name="unsArray"> Unsorted array </param>
-/// <param name="first"> First numer of array size (e.g., 0)</param>
-/// <param name="last"> Last number of array size (e.g., n)</param>
-int partitionLomuto(int unsArray[], int first, int last)
+// Class for writing a file block by block, a full block is written in the background
+template <typename T>
+class RunWriter
 {
-    // Define pivot
-    int pivotNumber = unsArray[last];
+    FILE* file;
+    vector<T> current, writing;     // Block being filled and block being written
+    size_t count;                   // Records in the current block
+    future<size_t> pending;         // Write of the previous block
+    size_t pendingRecords;          // Records of the previous block
+    bool failed;
+
+    // Waits for the previous write
+    void finishWrite()
+    {
+        if (pending.valid() && pending.get() != pendingRecords) {
+            failed = true;
+        }
+    }
 
-    // Define partition index
-    int partitionIndex = first;
+public:
 
-    // Loop first,...,last-1
-    for (int i = first; i < last; i++)
+    RunWriter(const string& path, size_t blockRecords) : current(blockRecords), writing(blockRecords), count(0), pendingRecords(0), failed(false)
     {
-        // If number unsArray[i] is less than pivot number, it gets swapped and partition index++ 
-        if (unsArray[i] <= pivotNumber)
-        {
-            swap(unsArray[i], unsArray[partitionIndex]);
-            partitionIndex++;
+        file = fopen(path.c_str(), "wb");
+        if (file != NULL) {
+            setvbuf(file, NULL, _IONBF, 0);
         }
+        failed = file == NULL;
     }
 
-    // Swaps partitionIndex with the pivotNumber (Last)
-    swap(unsArray[partitionIndex], unsArray[last]);
+    ~RunWriter()
+    {
+        close();
+    }
 
-    return partitionIndex;
-}
+    bool isOpen() const { return file != NULL; }
 
-/// <summary>
-///  Quick sort algorithm
-/// </summary>
-/// <param name="unsArray"> Unsorted array </param>
-/// <param name="first"> First numer of array size (e.g., 0)</param>
-/// <param name="last"> Last number of array size (e.g., n)</param>
-void quickSortAlgorithm(int unsArray[], int first, int last)
+    // Appends a record, ignored once a write failed or the file could not be created
+    void push(const T& record)
+    {
+        if (failed) {
+            return;
+        }
+        current[count++] = record;
+        if (count == current.size()) {
+            flush();
+        }
+    }
+
+    // Hands the current block to a background write
+    void flush()
+    {
+        finishWrite();
+        if (file == NULL || count == 0) {
+            return;
+        }
+        swap(current, writing);
+        FILE* target = file;
+        const T* source = writing.data();
+        size_t records = pendingRecords = count;
+        pending = async(launch::async, [target, source, records] { return fwrite(source, sizeof(T), records, target); });
+        count = 0;
+    }
+
+    // Writes the remaining records and closes the file, returns false if a write failed
+    bool close()
+    {
+        if (file != NULL) {
+            flush();
+            finishWrite();
+            failed = fclose(file) != 0 || failed;
+            file = NULL;
+        }
+        return !failed;
+    }
+};
+
+// Class for a k-way merge (tournament tree of losers)
+// Every inner node keeps the loser of its match and node 0 the overall winner, so replacing the winner
+// replays only the log2(k) matches on its path. Ties go to the lower run index (stable)
+template <typename T, typename Less>
+class LoserTree
 {
-    // Stopping criteria
-    if (first >= last) {
-        return;
+    vector<RunReader<T>*>& runs;
+    vector<int> tree;
+    int k;
+    Less lessThan;
+
+    // true if run a wins against run b
+    bool beats(int a, int b) const
+    {
+        if (runs[a]->empty()) {
+            return false;
+        }
+        if (runs[b]->empty()) {
+            return true;
+        }
+        if (lessThan(runs[b]->front(), runs[a]->front())) {
+            return false;
+        }
+        return lessThan(runs[a]->front(), runs[b]->front()) || a < b;
+    }
+
+public:
+
+    LoserTree(vector<RunReader<T>*>& runs, Less lessThan) : runs(runs), tree(max((size_t)1, runs.size())), k((int)runs.size()), lessThan(lessThan)
+    {
+        // Winners of every subtree, leaves are k..2k-1
+        vector<int> winnerOf(2 * k);
+        for (int i = 0; i < k; i++) {
+            winnerOf[k + i] = i;
+        }
+        for (int node = k - 1; node >= 1; node--) {
+            int a = winnerOf[2 * node], b = winnerOf[2 * node + 1];
+            bool aWins = beats(a, b);
+            winnerOf[node] = aWins ? a : b;
+            tree[node] = aWins ? b : a;
+        }
+        tree[0] = k == 1 ? 0 : winnerOf[1];
     }
 
-    // Applies Lomuto partition
-    int pivotIndex = partitionLomuto(unsArray, first, last);
+    // Run holding the smallest record, empty when all runs are consumed
+    RunReader<T>& top() { return *runs[tree[0]]; }
 
-    // Recurrent call for left side partition 
-    quickSortAlgorithm(unsArray, first, pivotIndex - 1);
+    // Pops the smallest record and replays its path
+    void pop()
+    {
+        int winner = tree[0];
+        runs[winner]->pop();
+        for (int node = (winner + k) / 2; node >= 1; node /= 2) {
+            if (beats(tree[node], winner)) {
+                swap(tree[node], winner);
+            }
+        }
+        tree[0] = winner;
+    }
+};
 
-    // Recurrent call for right side partition 
-    quickSortAlgorithm(unsArray, pivotIndex + 1, last);
-}
+/// <summary>
+///  Merges sorted run files into one file with a loser tree; every input and the output are double buffered
+/// </summary>
+/// <param name="inputs"> Sorted run files </param>
+/// <param name="output"> Output file </param>
+/// <param name="blockRecords"> Records per block </param>
+/// <param name="expectedRecords"> Records in all the inputs, a different count written is a failure </param>
+/// <param name="lessThan"> Strict weak order </param>
+template <typename T, typename Less>
+bool mergeRunFiles(const vector<string>& inputs, const string& output, size_t blockRecords, size_t expectedRecords, Less lessThan)
+{
+    vector<unique_ptr<RunReader<T> > > readers;
+    vector<RunReader<T>*> runs;
+    for (size_t r = 0; r < inputs.size(); r++) {
+        readers.push_back(unique_ptr<RunReader<T> >(new RunReader<T>(inputs[r], blockRecords)));
+        if (!readers.back()->isOpen()) {
+            return false;
+        }
+        runs.push_back(readers.back().get());
+    }
 
-#pragma endregion
+    RunWriter<T> writer(output, blockRecords);
+    if (!writer.isOpen()) {
+        return false;
+    }
+    size_t written = 0;
+    if (!runs.empty()) {
+        LoserTree<T, Less> tree(runs, lessThan);
+        while (!tree.top().empty()) {
+            writer.push(tree.top().front());
+            tree.pop();
+            written++;
+        }
+    }
 
-#pragma region Merge Sort Algorithm (Recursive)
+    bool ok = writer.close() && written == expectedRecords;
+    for (size_t r = 0; r < runs.size(); r++) {
+        ok = ok && !runs[r]->readFailed();
+    }
+    return ok;
+}
 
 /// <summary>
-///  Merges two arrays
+///  External merge sort of a binary file of fixed-size records that may not fit in memory
+///  Memory-sized chunks are sorted in parallel and written as runs; runs are then merged k at a time,
+///  where k is what fits in memory with two blocks per run, until a single merge writes the output.
+///  Reads are prefetched and writes are flushed in the background, so the merge streams at disk speed
 /// </summary>
-/// <param name="unsArray"> Unsorted array </param>
-/// <param name="auxsArray"> Auxiliary array </param>
-/// <param name="first"> First cell position of splitted array based on original   </param>
-/// <param name="middle"> Middle cell position of previous array splitting based on original  </param>
-/// <param name="last"> Last cell position of splitted array based on original </param>
-void mergeSort(int unsArray[], int auxArray[], int first, int middle, int last)
+/// <param name="inputPath"> File of records of type T </param>
+/// <param name="outputPath"> Sorted output file </param>
+/// <param name="options"> Memory, block size, temporary directory and its space limit </param>
+/// <param name="comp"> Comparator </param>
+/// <param name="proj"> Projection </param>
+template <typename T, typename Compare = less<>, typename Projection = Identity>
+bool externalSort(const string& inputPath, const string& outputPath, const ExternalSortOptions& options = ExternalSortOptions(),
+    Compare comp = Compare(), Projection proj = Projection())
 {
-    //Auxiliary
-    int k = first, i = first, j = middle + 1;
+    auto lessThan = makeLess(comp, proj);
+
+    // Blocks larger than a sixth of the memory are shrunk, so two inputs and the output fit in it
+    const size_t blockBytes = min(options.blockBytes, options.memoryBytes / 6);
+    const size_t blockRecords = max((size_t)1, blockBytes / sizeof(T));
+
+    // Runs: half of the memory holds the records, the other half the scratch of the parallel sort
+    const size_t runRecords = max(blockRecords, options.memoryBytes / (2 * sizeof(T)));
+    FILE* input = fopen(inputPath.c_str(), "rb");
+    if (input == NULL) {
+        return false;
+    }
 
-    // Compares value of each cell position in both halfs and sorts them in the auxArray
-    // Due to recursion, sorting will start with the smallest size arrays, each with one cell
-    while (i <= middle && j <= last)
+    const string prefix = runFilePrefix(options.tempDirectory);
+    vector<string> runs;
+    vector<size_t> runSizes;        // Records of every run
+    uint64_t tempUsed = 0;          // Bytes of the run files
+    vector<T> chunk(runRecords);
+    int pass = 0;
+    bool ok = true;
+    while (ok)
     {
-        if (unsArray[i] <= unsArray[j]) {
-            auxArray[k++] = unsArray[i++];
+        size_t records = fread(chunk.data(), sizeof(T), runRecords, input);
+        if (records == 0) {
+            break;
         }
-        else {
-            auxArray[k++] = unsArray[j++];
+        tempUsed += (uint64_t)records * sizeof(T);
+        if (tempUsed > options.tempBytes) {
+            ok = false;
+            break;
         }
+        parallelMergeSort(chunk.begin(), chunk.begin() + records, comp, proj);
+
+        runs.push_back(prefix + "0_" + to_string(runs.size()) + ".tmp");
+        runSizes.push_back(records);
+        FILE* run = fopen(runs.back().c_str(), "wb");
+        ok = run != NULL && fwrite(chunk.data(), sizeof(T), records, run) == records;
+        ok = (run != NULL && fclose(run) == 0) && ok;
     }
+    ok = !ferror(input) && ok;       // A short read is the end of the input only without an error
+    fclose(input);
+    vector<T>().swap(chunk);
+
+    // Runs merged at once: two blocks per input plus two for the output (at least 2 runs)
+    const size_t blockPairs = options.memoryBytes / (2 * blockRecords * sizeof(T));
+    const size_t fanIn = blockPairs > 2 ? blockPairs - 1 : 2;
+
+    // Intermediate passes until one merge can produce the output
+    while (ok && runs.size() > fanIn)
+    {
+        pass++;
+        vector<string> merged;
+        vector<size_t> mergedSizes;
+        size_t first = 0;
+        for (; ok && first < runs.size(); first += fanIn) {
+            size_t last = min(runs.size(), first + fanIn);
+            vector<string> group(runs.begin() + first, runs.begin() + last);
+            merged.push_back(prefix + to_string(pass) + "_" + to_string(merged.size()) + ".tmp");
+            mergedSizes.push_back(accumulate(runSizes.begin() + first, runSizes.begin() + last, (size_t)0));
+
+            // The group is removed once merged, so only the merged copy adds to the space in use
+            ok = tempUsed + (uint64_t)mergedSizes.back() * sizeof(T) <= options.tempBytes &&
+                mergeRunFiles<T>(group, merged.back(), blockRecords, mergedSizes.back(), lessThan);
+            for (size_t r = 0; r < group.size(); r++) {
+                remove(group[r].c_str());
+            }
+        }
 
-    // Copy remaining unsorted elements
-    while (i <= middle) {
-        auxArray[k++] = unsArray[i++];
+        // After a failed merge the later groups were never merged, remove them as well
+        for (size_t r = first; r < runs.size(); r++) {
+            remove(runs[r].c_str());
+        }
+        runs.swap(merged);
+        runSizes.swap(mergedSizes);
     }
 
-    // Copy sorted array in original
-    for (int i = first; i <= last; i++) {
-        unsArray[i] = auxArray[i];
+    const size_t totalRecords = accumulate(runSizes.begin(), runSizes.end(), (size_t)0);
+    ok = ok && mergeRunFiles<T>(runs, outputPath, blockRecords, totalRecords, lessThan);
+    for (size_t r = 0; r < runs.size(); r++) {
+        remove(runs[r].c_str());
     }
+    return ok;
 }
 
 /// <summary>
-///  Splits and merges the array recursively
+///  Sorts a file of random numbers with a memory budget far smaller than the file
 /// </summary>
-/// <param name="unsArray"> Unsorted array </param>
-/// /// <param name="auxsArray"> Auxiliary array </param>
-/// /// /// <param name="first"> First cell position of splitted array based on original   </param>
-/// /// /// <param name="last"> Last cell position of splitted array based on original </param>
-void splitMergeSort(int unsArray[], int auxArray[], int first, int last)
+void externalSortExample()
 {
-    // End recursion for array size 1
-    if (last == first) {
+    const int count = 100000;
+    const string inputPath = "external_sort_input.bin", outputPath = "external_sort_output.bin";
+
+    // Write random numbers (-50 to 50)
+    vector<int> numbers(count);
+    for (int i = 0; i < count; i++) {
+        numbers[i] = (rand() % 100) - 50;
+    }
+    FILE* file = fopen(inputPath.c_str(), "wb");
+    if (file == NULL) {
+        cout << "Could not write " << inputPath << endl;
         return;
     }
+    fwrite(numbers.data(), sizeof(int), count, file);
+    fclose(file);
+
+    // 64 KB of memory and 4 KB blocks: 13 runs of 32 KB, merged 7 at a time
+    ExternalSortOptions options;
+    options.memoryBytes = 64 << 10;
+    options.blockBytes = 4 << 10;
 
-    // Identify array middle size
-    int middle = (first + ((last - first) >> 1));
+    bool sorted = externalSort<int>(inputPath, outputPath, options);
+    file = sorted ? fopen(outputPath.c_str(), "rb") : NULL;
+    sorted = file != NULL && fread(numbers.data(), sizeof(int), count, file) == (size_t)count;
+    if (file != NULL) {
+        fclose(file);
+    }
+    sorted = sorted && is_sorted(numbers.begin(), numbers.end());
 
-    splitMergeSort(unsArray, auxArray, first, middle);        // Splits and merges first half
-    splitMergeSort(unsArray, auxArray, middle + 1, last);     // Splits and merges last half
+    cout << "Sorted " << count << " numbers (" << count * sizeof(int) / 1024 << " KB) with " << options.memoryBytes / 1024
+         << " KB of memory: " << (sorted ? "output is sorted" : "sort failed") << endl;
+    printArray(numbers.data(), N);
 
-    mergeSort(unsArray, auxArray, first, middle, last);        // Merges the two half
+    remove(inputPath.c_str());
+    remove(outputPath.c_str());
 }
 
+#pragma endregion
+
+#ifdef SORTING_BENCHMARK
 
-/// <summary>
-///  Merge sort algorithm (Recursive)
-/// </summary>
-/// <param name="unsArray"> Unsorted array </param>
-void mergeSortAlgorithm(int unsArray[], int n)
+#pragma region Sorting Benchmark
+
+// Settings of the benchmark, read from the command line (e.g. --max-size=100000000 --format=json)
+struct BenchmarkOptions
 {
+    long long maxSize;          // Largest input, sizes are 10, 100, ... up to maxSize (at most 10^8)
+    long long countLimit;       // Largest input of the instrumented run that counts comparisons and moves
+    int quadraticLimit;         // Largest input of bubble, selection and insertion sort
+    int trials;                 // Timed trials, the fastest is reported
+    int batchElements;          // Small inputs are sorted in batches of at least this many elements
+    string format;              // "csv" or "json"
 
-    int auxArray[N];
+    BenchmarkOptions() : maxSize(1000000), countLimit(1000000), quadraticLimit(1000), trials(3), batchElements(1 << 16), format("csv") {}
+};
 
-    // Copy auxiliary array
-    for (int i = 0; i < n; i++) {
-        auxArray[i] = unsArray[i];
+// Input distributions
+enum Distribution { Uniform, Sorted, Reverse, FewUnique, OrganPipe, Sawtooth, Zipf, DistributionCount };
+
+const char* distributionNames[DistributionCount] = { "uniform", "sorted", "reverse", "few-unique", "organ-pipe", "sawtooth", "zipf" };
+
+// Record of the benchmark, a 64-bit key with a 24-byte payload
+struct BenchmarkRecord
+{
+    int64_t key;
+    int64_t payload[3];
+
+    friend bool operator<(const BenchmarkRecord& a, const BenchmarkRecord& b) { return a.key < b.key; }
+    friend bool operator==(const BenchmarkRecord& a, const BenchmarkRecord& b) { return a.key == b.key; }
+};
+
+// Comparisons and moves of the instrumented key type, atomic because the parallel sorts share them
+struct OperationCounts
+{
+    atomic<long long> comparisons;
+    atomic<long long> moves;
+
+    static OperationCounts& shared()
+    {
+        static OperationCounts counts;
+        return counts;
+    }
+
+    void reset()
+    {
+        comparisons = 0;
+        moves = 0;
     }
+};
 
-    // Recursive merge function 
-    splitMergeSort(unsArray, auxArray, 0, n - 1);
+// Instrumented key type: counts every comparison and every copy or move (a swap is three moves)
+template <typename T>
+struct Counted
+{
+    T value;
 
-}
-#pragma endregion
+    Counted() : value() {}
+    Counted(const T& value) : value(value) {}
+    Counted(const Counted& other) : value(other.value) { OperationCounts::shared().moves.fetch_add(1, memory_order_relaxed); }
 
-#pragma region Bubble Sort Algorithm (Recursive)
+    Counted& operator=(const Counted& other)
+    {
+        value = other.value;
+        OperationCounts::shared().moves.fetch_add(1, memory_order_relaxed);
+        return *this;
+    }
+
+    friend bool operator<(const Counted& a, const Counted& b)
+    {
+        OperationCounts::shared().comparisons.fetch_add(1, memory_order_relaxed);
+        return a.value < b.value;
+    }
+};
 
 /// <summary>
-///  Bubble sort algorithm (Recursive)
+///  Keys of a distribution: uniform (full 64-bit range), sorted, reverse, few-unique (16 values),
+///  organ-pipe (ascending then descending), sawtooth (16 ascending runs) and Zipf (s = 1, 65536 ranks)
 /// </summary>
-/// <param name="unsArray"> Unsorted array </param>
-/// <param name="n"> Size of array </param>
-void bubbleSortAlgorithm(int unsArray[], int n)
+/// <param name="distribution"> Distribution of the keys </param>
+/// <param name="n"> Number of keys </param>
+/// <param name="rng"> Random number generator </param>
+vector<int64_t> generateKeys(Distribution distribution, int n, mt19937_64& rng)
 {
-    // Loop 0,...,n-1
-    for (int i = 0; i < n - 1; i++)
+    vector<int64_t> keys(n);
+    vector<double> zipfWeights;
+    if (distribution == Zipf) {
+        double total = 0;
+        for (int rank = 1; rank <= (1 << 16); rank++) {
+            zipfWeights.push_back(total += 1.0 / rank);
+        }
+    }
+
+    int tooth = max(1, n / 16);
+    for (int i = 0; i < n; i++)
     {
-        // Swap positions if two continous values are unsorted
-        if (unsArray[i] > unsArray[i + 1]) {
-            swap(unsArray[i], unsArray[i + 1]);
+        switch (distribution)
+        {
+        case Uniform:   keys[i] = (int64_t)rng(); break;
+        case Sorted:    keys[i] = i; break;
+        case Reverse:   keys[i] = n - i; break;
+        case FewUnique: keys[i] = (int64_t)(rng() % 16); break;
+        case OrganPipe: keys[i] = i < n / 2 ? i : n - i; break;
+        case Sawtooth:  keys[i] = i % tooth; break;
+        default:
+        {
+            double u = uniform_real_distribution<double>(0, zipfWeights.back())(rng);
+            keys[i] = upper_bound(zipfWeights.begin(), zipfWeights.end(), u) - zipfWeights.begin();
+        }
         }
     }
-    // Recursive call with n-1
-    if (n - 1 > 1) {
-        bubbleSortAlgorithm(unsArray, n - 1);
+    return keys;
+}
+
+// Value of a key type made from a generated key (int32 keeps the low 32 bits)
+template <typename T>
+T makeBenchmarkValue(int64_t key, int)
+{
+    return (T)key;
+}
+
+template <>
+BenchmarkRecord makeBenchmarkValue<BenchmarkRecord>(int64_t key, int i)
+{
+    return BenchmarkRecord{ key, { i, -i, key ^ i } };
+}
+
+// Sorting algorithm of the benchmark
+template <typename T>
+struct BenchmarkAlgorithm
+{
+    string name;
+    long long maxSize;                      // Skipped above this size
+    bool comparisonSort;                    // false: no comparisons to count (radix sort)
+    function<void(T*, int)> sort;
+};
+
+/// <summary>
+///  Algorithms benchmarked on values of type T, std::sort and std::stable_sort first as baselines
+/// </summary>
+template <typename T>
+vector<BenchmarkAlgorithm<T> > benchmarkAlgorithms(const BenchmarkOptions& options)
+{
+    const long long all = options.maxSize;
+    const long long quadratic = options.quadraticLimit;
+    vector<BenchmarkAlgorithm<T> > algorithms = {
+        { "std::sort", all, true, [](T* a, int n) { sort(a, a + n); } },
+        { "std::stable_sort", all, true, [](T* a, int n) { stable_sort(a, a + n); } },
+        { "introsort", all, true, [](T* a, int n) { introSort(a, a + n); } },
+        { "merge sort", all, true, [](T* a, int n) { mergeSort(a, a + n); } },
+        { "timsort", all, true, [](T* a, int n) { timSort(a, a + n); } },
+        { "heap sort", all, true, [](T* a, int n) { heapSort(a, a + n); } },
+        { "parallel merge sort", all, true, [](T* a, int n) { parallelMergeSort(a, a + n); } },
+        { "parallel sample sort", all, true, [](T* a, int n) { parallelSampleSort(a, a + n); } },
+        { "insertion sort", quadratic, true, [](T* a, int n) { insertionSort(a, a + n); } },
+        { "selection sort", quadratic, true, [](T* a, int n) { selectionSort(a, a + n); } },
+        { "bubble sort", quadratic, true, [](T* a, int n) { bubbleSort(a, a + n); } }
+    };
+    if constexpr (is_integral<T>::value) {
+        algorithms.push_back({ "radix sort", all, false, [](T* a, int n) { radixSortPairs<T, int>(a, nullptr, n); } });
     }
+    return algorithms;
 }
-#pragma endregion
 
-#pragma region Selection Sort Algrithm
+// Measurements of one algorithm on one input
+struct BenchmarkResult
+{
+    string algorithm, keyType, distribution;
+    int n;
+    double nsPerElement;
+    double elementsPerSecond;
+    long long comparisons, moves;     // -1 when not counted
+    bool sorted;
+};
+
+// Count as text, empty (CSV) or null (JSON) when not counted
+string countText(long long value, const char* missing)
+{
+    return value < 0 ? string(missing) : to_string(value);
+}
 
 /// <summary>
-///  Selection sort algorithm
+///  Writes a result as a CSV line or a JSON object
 /// </summary>
-/// <param name="unsArray"> Unsorted array </param>
-/// <param name="n"> Size of array </param>
-void selectionSortAlgorithm(int unsArray[], int n)
+/// <param name="result"> Measurements </param>
+/// <param name="options"> Output format </param>
+/// <param name="first"> true for the first result (no separator before a JSON object) </param>
+void printBenchmarkResult(const BenchmarkResult& result, const BenchmarkOptions& options, bool first)
 {
-    // 1st Loop 0,...,n-1
-    for (int i = 0; i < n - 1; i++)
-    { 
-        // Identify minimum number from unsArray[i,...,n-1]
-        int minNumber = i;
+    if (options.format == "json") {
+        printf("%s  { \"algorithm\": \"%s\", \"key\": \"%s\", \"distribution\": \"%s\", \"n\": %d, \"ns_per_element\": %.3f, "
+               "\"elements_per_second\": %.0f, \"comparisons\": %s, \"moves\": %s, \"sorted\": %s }",
+               first ? "" : ",\n", result.algorithm.c_str(), result.keyType.c_str(), result.distribution.c_str(), result.n,
+               result.nsPerElement, result.elementsPerSecond, countText(result.comparisons, "null").c_str(),
+               countText(result.moves, "null").c_str(), result.sorted ? "true" : "false");
+    }
+    else {
+        printf("%s,%s,%s,%d,%.3f,%.0f,%s,%s,%d\n", result.algorithm.c_str(), result.keyType.c_str(), result.distribution.c_str(),
+               result.n, result.nsPerElement, result.elementsPerSecond, countText(result.comparisons, "").c_str(),
+               countText(result.moves, "").c_str(), result.sorted ? 1 : 0);
+    }
+    fflush(stdout);
+}
 
-        // 2nd Loop i+1,...,n-1
-        for (int j = i + 1; j < n; j++)
+/// <summary>
+///  Benchmarks every algorithm on keys of type T, for every size and distribution
+///  Small inputs are sorted as a batch of copies so the clock resolution does not matter; the fastest
+///  of the trials is reported. A separate run on Counted<T> counts comparisons and moves
+/// </summary>
+/// <param name="keyType"> Name of the key type in the output </param>
+/// <param name="options"> Benchmark settings </param>
+/// <param name="first"> true until the first result is written </param>
+template <typename T>
+void benchmarkKeyType(const string& keyType, const BenchmarkOptions& options, bool& first)
+{
+    vector<BenchmarkAlgorithm<T> > algorithms = benchmarkAlgorithms<T>(options);
+    vector<BenchmarkAlgorithm<Counted<T> > > instrumented = benchmarkAlgorithms<Counted<T> >(options);
+    mt19937_64 rng(2024);
+
+    for (long long size = 10; size <= options.maxSize; size *= 10)
+    {
+        int n = (int)size;
+        int copies = max(1, options.batchElements / n);
+        for (int d = 0; d < DistributionCount; d++)
         {
-            // Identify index of the minimum from 2nd Loop
-            if (unsArray[j] < unsArray[minNumber]) {
-                minNumber = j;
+            vector<int64_t> keys = generateKeys((Distribution)d, n, rng);
+            vector<T> input(n);
+            for (int i = 0; i < n; i++) {
+                input[i] = makeBenchmarkValue<T>(keys[i], i);
             }
-        }
+            vector<T> batch((size_t)copies * n);
 
-        // Swap two numbers of an array based on the provided indexes
-        swap(unsArray[minNumber], unsArray[i]);
-    }
-}
+            for (size_t a = 0; a < algorithms.size(); a++)
+            {
+                if (n > algorithms[a].maxSize) {
+                    continue;
+                }
 
-#pragma endregion
+                double bestNs = 1e300;
+                for (int trial = 0; trial < options.trials; trial++) {
+                    for (int c = 0; c < copies; c++) {
+                        copy(input.begin(), input.end(), batch.begin() + (size_t)c * n);
+                    }
+                    auto start = chrono::steady_clock::now();
+                    for (int c = 0; c < copies; c++) {
+                        algorithms[a].sort(batch.data() + (size_t)c * n, n);
+                    }
+                    bestNs = min(bestNs, chrono::duration<double, nano>(chrono::steady_clock::now() - start).count());
+                }
 
-#pragma region Insertion Sort Algorithm
+                BenchmarkResult result;
+                result.algorithm = algorithms[a].name;
+                result.keyType = keyType;
+                result.distribution = distributionNames[d];
+                result.n = n;
+                result.nsPerElement = bestNs / ((double)copies * n);
+                result.elementsPerSecond = 1e9 / max(result.nsPerElement, 1e-9);
+                result.sorted = is_sorted(batch.begin(), batch.begin() + n);
+                result.comparisons = result.moves = -1;
+
+                if (algorithms[a].comparisonSort && a < instrumented.size() && n <= options.countLimit) {
+                    vector<Counted<T> > counted(input.begin(), input.end());
+                    OperationCounts::shared().reset();
+                    instrumented[a].sort(counted.data(), n);
+                    result.comparisons = OperationCounts::shared().comparisons;
+                    result.moves = OperationCounts::shared().moves;
+                }
+
+                printBenchmarkResult(result, options, first);
+                first = false;
+            }
+        }
+    }
+}
 
 /// <summary>
-///  Insertion sort algorithm
+///  Reads the benchmark settings: --max-size=N, --count-limit=N, --quadratic-limit=N, --trials=N,
+///  --batch=N and --format=csv|json
 /// </summary>
-/// <param name="unsArray"> Unsorted array </param>
-/// <param name="n"> Size of array </param>
-void insertionSortAlgorithm(int unsArray[], int n)
+BenchmarkOptions parseBenchmarkOptions(int argc, char* argv[])
 {
-    // Loop 1,...,n
-    for (int i = 1; i < n; i++)
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; i++)
     {
-        // Save the ith unsorted number and set the j index
-        int number = unsArray[i];
-        int j = i;
+        string argument = argv[i];
+        size_t equals = argument.find('=');
+        string name = argument.substr(0, equals);
+        string value = equals == string::npos ? "" : argument.substr(equals + 1);
 
-        // Identify the position the number belongs to in the sorted array
-        while (j > 0 && unsArray[j - 1] > number)
-        {
-            unsArray[j] = unsArray[j - 1];
-            j--;
+        if (name == "--max-size") {
+            options.maxSize = min(100000000LL, atoll(value.c_str()));
+        }
+        else if (name == "--count-limit") {
+            options.countLimit = atoll(value.c_str());
         }
+        else if (name == "--quadratic-limit") {
+            options.quadraticLimit = atoi(value.c_str());
+        }
+        else if (name == "--trials") {
+            options.trials = max(1, atoi(value.c_str()));
+        }
+        else if (name == "--batch") {
+            options.batchElements = max(1, atoi(value.c_str()));
+        }
+        else if (name == "--format") {
+            options.format = value;
+        }
+        else {
+            cerr << "Unknown option " << argument << endl;
+        }
+    }
+    return options;
+}
 
-        // Update number to the identified position
-        unsArray[j] = number;
+/// <summary>
+///  Runs the benchmark on int32, int64 and record keys and writes CSV or JSON to standard output
+/// </summary>
+int runSortingBenchmark(const BenchmarkOptions& options)
+{
+    bool first = true;
+    if (options.format == "json") {
+        printf("[\n");
+    }
+    else {
+        printf("algorithm,key,distribution,n,ns_per_element,elements_per_second,comparisons,moves,sorted\n");
     }
+
+    benchmarkKeyType<int32_t>("int32", options, first);
+    benchmarkKeyType<int64_t>("int64", options, first);
+    benchmarkKeyType<BenchmarkRecord>("record", options, first);
+
+    if (options.format == "json") {
+        printf("\n]\n");
+    }
+    return 0;
 }
-#pragma endregion 
+
+#pragma endregion
+
+#endif
+
+#ifdef SORTING_BENCHMARK
+
+// Benchmark build (-DSORTING_BENCHMARK): times every sort instead of running the examples
+int main(int argc, char* argv[]) {
+
+    return runSortingBenchmark(parseBenchmarkOptions(argc, argv));
+}
+
+#else
 
 int main() {
 
@@ -297,13 +2826,13 @@ int main() {
     printArray(sortedArray, n);
     cout << endl;
 
-    cout << " - Quick sort algorithm" << endl;
+    cout << " - Quick sort algorithm (introsort)" << endl;
     quickSortAlgorithm(sortedArray, 0, n-1);
     printArray(sortedArray, n);
     copy(begin(unsortedArray), end(unsortedArray), begin(sortedArray));
     cout << endl;
 
-    cout << " - Merge sort algorithm (recursive)" << endl;
+    cout << " - Merge sort algorithm (bottom-up)" << endl;
     mergeSortAlgorithm(sortedArray, n);
     printArray(sortedArray, n);
 
@@ -328,7 +2857,80 @@ int main() {
     copy(begin(unsortedArray), end(unsortedArray), begin(sortedArray));
     cout << endl;
 
+    cout << " - Heap sort algorithm" << endl;
+    heapSortAlgorithm(sortedArray, n);
+    printArray(sortedArray, n);
+    copy(begin(unsortedArray), end(unsortedArray), begin(sortedArray));
+    cout << endl;
+
+    cout << " - Parallel merge sort algorithm" << endl;
+    parallelMergeSortAlgorithm(sortedArray, n);
+    printArray(sortedArray, n);
+    copy(begin(unsortedArray), end(unsortedArray), begin(sortedArray));
+    cout << endl;
+
+    cout << " - Parallel sample sort algorithm" << endl;
+    parallelSampleSortAlgorithm(sortedArray, n);
+    printArray(sortedArray, n);
+    copy(begin(unsortedArray), end(unsortedArray), begin(sortedArray));
+    cout << endl;
+
+    cout << " - Radix sort algorithm (LSD)" << endl;
+    radixSortAlgorithm(sortedArray, n);
+    printArray(sortedArray, n);
+    copy(begin(unsortedArray), end(unsortedArray), begin(sortedArray));
+    cout << endl;
+
+    cout << " - Radix sort of keys with payload (original positions)" << endl;
+    int positions[N];
+    for (int i = 0; i < n; i++) {
+        positions[i] = i;
+    }
+    radixSortPairs(sortedArray, positions, n);
+    printArray(positions, n);
+    copy(begin(unsortedArray), end(unsortedArray), begin(sortedArray));
+    cout << endl;
+
+    cout << " - Generic sort of records (comparator and projection) and argsort" << endl;
+    sortFacilitiesExample();
+    cout << endl;
+
+    cout << " - External merge sort (runs, loser tree merge, read-ahead)" << endl;
+    externalSortExample();
+    cout << endl;
+
+    cout << " - Selection (nth element, partial sort, streaming top-k)" << endl;
+    nthElementAlgorithm(sortedArray, n, n / 2);
+    cout << "Median: " << sortedArray[n / 2] << endl;
+    copy(begin(unsortedArray), end(unsortedArray), begin(sortedArray));
+    partialSortAlgorithm(sortedArray, n, 3);
+    cout << "3 smallest: ";
+    printArray(sortedArray, 3);
+    TopK<int, greater<> > largest(3);
+    for (int i = 0; i < n; i++) {
+        largest.push(unsortedArray[i]);
+    }
+    vector<int> top = largest.sorted();
+    cout << "3 largest (streamed): ";
+    printArray(top.data(), (int)top.size());
+    copy(begin(unsortedArray), end(unsortedArray), begin(sortedArray));
+    cout << endl;
+
+    cout << " - Sorting network (" << sortingNetwork<N>.size << " comparators for " << N << " numbers)" << endl;
+    smallSortAlgorithm(sortedArray, n);
+    printArray(sortedArray, n);
+    copy(begin(unsortedArray), end(unsortedArray), begin(sortedArray));
+    cout << endl;
+
+    cout << " - TimSort algorithm (natural runs, powersort merges, galloping)" << endl;
+    timSortAlgorithm(sortedArray, n);
+    printArray(sortedArray, n);
+    copy(begin(unsortedArray), end(unsortedArray), begin(sortedArray));
+    cout << endl;
+
     cout << endl;
 
     return 0;
 }
+
+#endif